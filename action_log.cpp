@@ -0,0 +1,364 @@
+#include "action_log.h"
+#include "game.h"
+#include "state_hash.h"
+
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+/// The first bytes of an action log file
+static const char action_log_magic[4] = {'G', 'A', 'L', 'G'};
+
+/// The mask with all actions a player can do
+static unsigned int get_all_actions_mask() noexcept
+{
+  return (1u << (static_cast<unsigned int>(action_type::shoot_stun_rocket) + 1)) - 1;
+}
+
+action_log::action_log(const environment& e,
+                       const int n_players,
+                       const int n_shelters,
+                       const int n_enemies,
+                       const int n_food,
+                       const int seed,
+                       const bool has_state_hashes):
+  m_environment{e},
+  m_n_players{n_players},
+  m_n_shelters{n_shelters},
+  m_n_enemies{n_enemies},
+  m_n_food{n_food},
+  m_seed{seed},
+  m_has_state_hashes{has_state_hashes},
+  m_n_ticks{0},
+  m_previous_masks(static_cast<std::size_t>(std::max(n_players, 0)), 0)
+{
+  if (m_n_players < 0 || m_n_shelters < 0 || m_n_enemies < 0 || m_n_food < 0)
+    {
+      throw std::invalid_argument("Action log settings cannot be negative");
+    }
+}
+
+void action_log::add_actions(const game& g)
+{
+  const std::vector<player>& players = g.get_v_player();
+  if (static_cast<int>(players.size()) != m_n_players)
+    {
+      throw std::invalid_argument("Action log has a different number of players than the game");
+    }
+  int n_changed{0};
+  for (int i = 0; i != m_n_players; ++i)
+    {
+      if (players[i].get_action_set().get_bits() != m_previous_masks[i]) ++n_changed;
+    }
+  m_actions.put_varint(static_cast<std::uint64_t>(n_changed));
+  int previous_index{-1};
+  for (int i = 0; i != m_n_players && n_changed != 0; ++i)
+    {
+      const unsigned int mask{players[i].get_action_set().get_bits()};
+      if (mask == m_previous_masks[i]) continue;
+      m_actions.put_varint(static_cast<std::uint64_t>(i - previous_index - 1));
+      m_actions.put_varint(mask ^ m_previous_masks[i]);
+      m_previous_masks[i] = mask;
+      previous_index = i;
+    }
+  ++m_n_ticks;
+}
+
+void action_log::add_state_hash(const std::uint64_t state_hash)
+{
+  assert(m_has_state_hashes);
+  m_state_hashes.push_back(state_hash);
+}
+
+action_log_reader::action_log_reader(const action_log& log):
+  m_reader(log.get_action_bytes()),
+  m_masks(static_cast<std::size_t>(log.get_n_players()), 0)
+{
+}
+
+void action_log_reader::read_next_tick()
+{
+  const int n_players{static_cast<int>(m_masks.size())};
+  const int n_changed{static_cast<int>(m_reader.get_varint(static_cast<std::uint64_t>(n_players)))};
+  int index{-1};
+  for (int i = 0; i != n_changed; ++i)
+    {
+      index += 1 + static_cast<int>(m_reader.get_varint(static_cast<std::uint64_t>(n_players)));
+      if (index >= n_players)
+        {
+          throw std::invalid_argument("Action log has an action of a player that does not exist");
+        }
+      m_masks[index] ^= static_cast<unsigned int>(m_reader.get_varint(get_all_actions_mask()));
+    }
+}
+
+void action_log_reader::apply_next_tick(game& g)
+{
+  const int n_players{static_cast<int>(m_masks.size())};
+  assert(static_cast<int>(g.get_v_player().size()) == n_players);
+  read_next_tick();
+  for (int i = 0; i != n_players; ++i)
+    {
+      g.get_player(i).get_action_set().set_bits(m_masks[i]);
+    }
+}
+
+game create_game(const action_log& log)
+{
+  return game(log.get_env(),
+              log.get_n_players(),
+              0,
+              static_cast<std::size_t>(log.get_n_shelters()),
+              log.get_n_enemies(),
+              log.get_n_food(),
+              log.get_seed());
+}
+
+void record_tick(game& g, action_log& log)
+{
+  log.add_actions(g);
+  g.tick();
+  if (log.has_state_hashes()) log.add_state_hash(calc_state_hash(g));
+}
+
+void save(const action_log& log, std::ostream& os)
+{
+  binary_writer w;
+  w.put_bytes(action_log_magic, sizeof(action_log_magic));
+  w.put_varint(static_cast<std::uint64_t>(action_log::get_version()));
+  w.put_double(log.get_env().get_wall_s_side());
+  w.put_varint(static_cast<std::uint64_t>(log.get_env().get_type()));
+  w.put_varint(static_cast<std::uint64_t>(log.get_n_players()));
+  w.put_varint(static_cast<std::uint64_t>(log.get_n_shelters()));
+  w.put_varint(static_cast<std::uint64_t>(log.get_n_enemies()));
+  w.put_varint(static_cast<std::uint64_t>(log.get_n_food()));
+  w.put_signed_varint(log.get_seed());
+  w.put_varint(log.has_state_hashes() ? 1 : 0);
+  w.put_varint(static_cast<std::uint64_t>(log.get_n_ticks()));
+  w.put_varint(log.get_action_bytes().size());
+  w.put_bytes(log.get_action_bytes().data(), log.get_action_bytes().size());
+  for (const auto state_hash : log.get_state_hashes())
+    {
+      w.put_u64(state_hash);
+    }
+  os.write(reinterpret_cast<const char*>(w.get_bytes().data()),
+           static_cast<std::streamsize>(w.get_bytes().size()));
+}
+
+action_log load_action_log(std::istream& is)
+{
+  const std::vector<std::uint8_t> bytes{
+    std::istreambuf_iterator<char>(is),
+    std::istreambuf_iterator<char>()
+  };
+  binary_reader r(bytes);
+  char magic[sizeof(action_log_magic)];
+  r.get_bytes(magic, sizeof(magic));
+  if (std::memcmp(magic, action_log_magic, sizeof(magic)) != 0)
+    {
+      throw std::invalid_argument("Data is not an action log");
+    }
+  if (r.get_varint() != static_cast<std::uint64_t>(action_log::get_version()))
+    {
+      throw std::invalid_argument("Action log has an unknown version");
+    }
+  const double wall_short_side{r.get_double()};
+  const auto type = static_cast<environment_type>(
+    r.get_varint(static_cast<std::uint64_t>(environment_type::wormhole))
+  );
+  const std::uint64_t max_n_items{static_cast<std::uint64_t>(action_log::get_max_n_items())};
+  const int n_players{static_cast<int>(r.get_varint(max_n_items))};
+  const int n_shelters{static_cast<int>(r.get_varint(max_n_items))};
+  const int n_enemies{static_cast<int>(r.get_varint(max_n_items))};
+  const int n_food{static_cast<int>(r.get_varint(max_n_items))};
+  const std::int64_t seed{r.get_signed_varint()};
+  if (seed < INT_MIN || seed > INT_MAX)
+    {
+      throw std::invalid_argument("Action log has a seed that is too big");
+    }
+  const bool has_state_hashes{r.get_varint(1) == 1};
+  action_log log(environment(wall_short_side, type),
+                 n_players, n_shelters, n_enemies, n_food,
+                 static_cast<int>(seed), has_state_hashes);
+  log.m_n_ticks = static_cast<int>(r.get_varint(INT_MAX));
+  const std::size_t n_action_bytes{static_cast<std::size_t>(r.get_varint(r.get_n_bytes_left()))};
+  log.m_actions.put_bytes(r.get_position(), n_action_bytes);
+  r.skip(n_action_bytes);
+  if (has_state_hashes)
+    {
+      if (r.get_n_bytes_left() / 8 < static_cast<std::size_t>(log.m_n_ticks))
+        {
+          throw std::invalid_argument("Action log ends too early");
+        }
+      log.m_state_hashes.resize(static_cast<std::size_t>(log.m_n_ticks));
+      for (auto& state_hash : log.m_state_hashes)
+        {
+          state_hash = r.get_u64();
+        }
+    }
+  if (!r.is_done())
+    {
+      throw std::invalid_argument("Action log has data after its end");
+    }
+
+  // Decode all ticks once, so that a replay cannot hit a corrupt tick
+  // and the masks of the latest tick are known to log more ticks
+  action_log_reader reader(log);
+  for (int tick = 0; tick != log.m_n_ticks; ++tick)
+    {
+      reader.read_next_tick();
+    }
+  if (!reader.is_done())
+    {
+      throw std::invalid_argument("Action log has more ticks than it says");
+    }
+  log.m_previous_masks = reader.get_masks();
+  return log;
+}
+
+void test_action_log() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A new log has no ticks
+  {
+    const action_log log;
+    assert(log.get_n_ticks() == 0);
+    assert(log.get_action_bytes().empty());
+    assert(log.get_state_hashes().empty());
+  }
+  // A tick in which no actions change takes one byte
+  {
+    game g;
+    action_log log;
+    record_tick(g, log);
+    record_tick(g, log);
+    assert(log.get_n_ticks() == 2);
+    assert(log.get_action_bytes().size() == 2);
+    assert(log.get_state_hashes().size() == 2);
+    assert(log.get_state_hashes().back() == calc_state_hash(g));
+  }
+  // The reader gives back the logged actions
+  {
+    game g;
+    action_log log;
+    g.get_player(1).get_action_set().insert(action_type::accelerate);
+    record_tick(g, log);
+    g.get_player(1).get_action_set().insert(action_type::turn_left);
+    g.get_player(2).get_action_set().insert(action_type::shoot);
+    record_tick(g, log);
+    g.get_player(1).get_action_set().clear();
+    record_tick(g, log);
+
+    game h = create_game(log);
+    action_log_reader reader(log);
+    reader.apply_next_tick(h);
+    assert(h.get_player(0).get_action_set().empty());
+    assert(h.get_player(1).get_action_set() == action_set{action_type::accelerate});
+    reader.apply_next_tick(h);
+    assert(h.get_player(1).get_action_set()
+           == action_set({action_type::accelerate, action_type::turn_left}));
+    assert(h.get_player(2).get_action_set() == action_set{action_type::shoot});
+    reader.apply_next_tick(h);
+    assert(h.get_player(1).get_action_set().empty());
+    assert(h.get_player(2).get_action_set() == action_set{action_type::shoot});
+    assert(reader.is_done());
+  }
+  // A log can be saved and loaded, after which it can be extended
+  {
+    game g(environment(1000, environment_type::quiet), 4, 0, 5, 1, 3, -17);
+    action_log log(g.get_env(), 4, 5, 1, 3, -17);
+    g.get_player(3).get_action_set().insert(action_type::brake);
+    record_tick(g, log);
+    std::stringstream s;
+    save(log, s);
+    action_log loaded = load_action_log(s);
+    assert(loaded.get_env().get_wall_s_side() == 1000);
+    assert(loaded.get_env().get_type() == environment_type::quiet);
+    assert(loaded.get_n_players() == 4);
+    assert(loaded.get_n_shelters() == 5);
+    assert(loaded.get_n_food() == 3);
+    assert(loaded.get_seed() == -17);
+    assert(loaded.get_n_ticks() == 1);
+    assert(loaded.get_action_bytes() == log.get_action_bytes());
+    assert(loaded.get_state_hashes() == log.get_state_hashes());
+    record_tick(g, log);
+    record_tick(g, loaded);
+    assert(loaded.get_action_bytes() == log.get_action_bytes());
+  }
+  // The game of a log is the game that was logged
+  {
+    const game g(environment(), 3, 0, 42, 1, 1, 123);
+    const action_log log(g.get_env(), 3, 42, 1, 1, 123);
+    assert(calc_state_hash(create_game(log)) == calc_state_hash(g));
+  }
+  // Bad data is rejected
+  {
+    game g;
+    action_log log;
+    g.get_player(0).get_action_set().insert(action_type::shoot);
+    record_tick(g, log);
+    std::stringstream s;
+    save(log, s);
+    const std::string good{s.str()};
+    const std::vector<std::string> bads{
+      "",
+      "NOPE" + good.substr(4),
+      good.substr(0, good.size() - 1),
+      good + "x"
+    };
+    for (const auto& bad : bads)
+      {
+        std::stringstream t(bad);
+        bool has_thrown{false};
+        try
+        {
+          load_action_log(t);
+        }
+        catch (const std::invalid_argument&)
+        {
+          has_thrown = true;
+        }
+        assert(has_thrown);
+      }
+  }
+  // A log with too many players, shelters, enemies or food items is not loaded
+  {
+    const int too_many{action_log::get_max_n_items() + 1};
+    const std::vector<action_log> logs{
+      action_log(environment(), too_many, 0, 0, 0),
+      action_log(environment(), 0, too_many, 0, 0),
+      action_log(environment(), 0, 0, too_many, 0),
+      action_log(environment(), 0, 0, 0, too_many)
+    };
+    for (const auto& log : logs)
+      {
+        std::stringstream s;
+        save(log, s);
+        bool has_thrown{false};
+        try
+        {
+          load_action_log(s);
+        }
+        catch (const std::invalid_argument&)
+        {
+          has_thrown = true;
+        }
+        assert(has_thrown);
+      }
+  }
+  // A log with the most items it can have is loaded
+  {
+    const int n{action_log::get_max_n_items()};
+    const action_log log(environment(), 1, n, 1, n);
+    std::stringstream s;
+    save(log, s);
+    const action_log loaded{load_action_log(s)};
+    assert(loaded.get_n_shelters() == n);
+    assert(loaded.get_n_food() == n);
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,127 @@
+#ifndef ACTION_LOG_H
+#define ACTION_LOG_H
+
+#include "binary_io.h"
+#include "environment.h"
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+class game;
+
+/// A compact log of the actions of all players in all ticks of a game,
+/// to replay the game exactly. It logs the settings a game is created with,
+/// so it can only log games that are created with the game constructor.
+///
+/// Per tick, it stores what changed compared to the tick before:
+/// the number of players whose actions changed, then for each such
+/// player the distance to the previous such player and the bits that
+/// changed (the XOR of the action masks), all as varints. A tick in which
+/// no player changes its actions takes one byte. Optionally, it stores
+/// the hash of the game state after each tick, to detect divergence
+class action_log
+{
+public:
+  /// Start the log of a game created as
+  /// game(e, n_players, 0, n_shelters, n_enemies, n_food, seed)
+  /// @param has_state_hashes log a state hash after every tick
+  action_log(const environment& e = environment(),
+             const int n_players = 3,
+             const int n_shelters = 42,
+             const int n_enemies = 1,
+             const int n_food = 1,
+             const int seed = 0,
+             const bool has_state_hashes = true);
+
+  /// Log the actions of all players, to be done just before game::tick
+  void add_actions(const game& g);
+
+  /// Log the state hash after a tick, to be done just after game::tick
+  void add_state_hash(const std::uint64_t state_hash);
+
+  const environment& get_env() const noexcept { return m_environment; }
+  int get_n_players() const noexcept { return m_n_players; }
+  int get_n_shelters() const noexcept { return m_n_shelters; }
+  int get_n_enemies() const noexcept { return m_n_enemies; }
+  int get_n_food() const noexcept { return m_n_food; }
+  int get_seed() const noexcept { return m_seed; }
+  bool has_state_hashes() const noexcept { return m_has_state_hashes; }
+
+  /// The number of ticks logged
+  int get_n_ticks() const noexcept { return m_n_ticks; }
+
+  /// The encoded actions of all ticks
+  const std::vector<std::uint8_t>& get_action_bytes() const noexcept { return m_actions.get_bytes(); }
+
+  /// The state hash after each tick, empty if these are not logged
+  const std::vector<std::uint64_t>& get_state_hashes() const noexcept { return m_state_hashes; }
+
+  /// The version of the file format, increase it upon a change
+  static int get_version() noexcept { return 1; }
+
+  /// The most players, shelters, enemies or food items a loaded log
+  /// can have, so that a corrupt log cannot make the loader or
+  /// the replayed game allocate too much memory
+  static int get_max_n_items() noexcept { return 1 << 16; }
+
+private:
+  friend action_log load_action_log(std::istream& is);
+
+  environment m_environment;
+  int m_n_players;
+  int m_n_shelters;
+  int m_n_enemies;
+  int m_n_food;
+  int m_seed;
+  bool m_has_state_hashes;
+  int m_n_ticks;
+  binary_writer m_actions;
+  std::vector<std::uint64_t> m_state_hashes;
+
+  /// The action mask of each player in the latest logged tick
+  std::vector<unsigned int> m_previous_masks;
+};
+
+/// Reads the actions of an action_log tick by tick
+class action_log_reader
+{
+public:
+  explicit action_log_reader(const action_log& log);
+
+  /// Are all ticks read?
+  bool is_done() const noexcept { return m_reader.is_done(); }
+
+  /// Read the actions of the next tick.
+  /// Throws std::invalid_argument if the log is corrupt
+  void read_next_tick();
+
+  /// Read the actions of the next tick and give these to the players.
+  /// Throws std::invalid_argument if the log is corrupt
+  void apply_next_tick(game& g);
+
+  /// The action mask of each player in the latest read tick
+  const std::vector<unsigned int>& get_masks() const noexcept { return m_masks; }
+
+private:
+  binary_reader m_reader;
+  std::vector<unsigned int> m_masks;
+};
+
+/// Create the game an action log starts with
+game create_game(const action_log& log);
+
+/// Log the actions of the players, tick the game,
+/// then log the state hash, if the log has these
+void record_tick(game& g, action_log& log);
+
+/// Write an action log in its binary format
+void save(const action_log& log, std::ostream& os);
+
+/// Read an action log from its binary format.
+/// Throws std::invalid_argument if the data is not a valid action log
+action_log load_action_log(std::istream& is);
+
+/// Test the action_log class
+void test_action_log();
+
+#endif // ACTION_LOG_H
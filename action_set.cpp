@@ -0,0 +1,127 @@
+#include "action_set.h"
+#include <cassert>
+#include <set>
+#include <vector>
+
+action_type action_set::const_iterator::operator*() const noexcept
+{
+  assert(m_bits != 0);
+  unsigned int value{0};
+  while (!(m_bits & (1u << value))) ++value;
+  return static_cast<action_type>(value);
+}
+
+action_set::const_iterator& action_set::const_iterator::operator++() noexcept
+{
+  // Remove the lowest bit that is set
+  m_bits &= m_bits - 1;
+  return *this;
+}
+
+action_set::const_iterator action_set::const_iterator::operator++(int) noexcept
+{
+  const const_iterator before{*this};
+  ++(*this);
+  return before;
+}
+
+action_set::action_set(std::initializer_list<action_type> actions) noexcept
+  : m_bits{0}
+{
+  for (const auto action : actions) insert(action);
+}
+
+std::size_t action_set::erase(const action_type action) noexcept
+{
+  const std::size_t n{count(action)};
+  m_bits &= ~to_bit(action);
+  return n;
+}
+
+std::size_t action_set::size() const noexcept
+{
+  std::size_t n{0};
+  for (unsigned int bits = m_bits; bits != 0; bits &= bits - 1) ++n;
+  return n;
+}
+
+bool operator==(const action_set& lhs, const action_set& rhs) noexcept
+{
+  return lhs.get_bits() == rhs.get_bits();
+}
+
+bool operator!=(const action_set& lhs, const action_set& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+void test_action_set()
+{
+#ifndef NDEBUG // no tests in release
+  // A new set is empty
+  {
+    const action_set s;
+    assert(s.empty());
+    assert(s.size() == 0);
+    assert(s.begin() == s.end());
+  }
+  // Actions can be inserted once
+  {
+    action_set s;
+    s.insert(action_type::brake);
+    s.insert(action_type::brake);
+    assert(!s.empty());
+    assert(s.size() == 1);
+    assert(s.count(action_type::brake) == 1);
+    assert(s.count(action_type::accelerate) == 0);
+  }
+  // Erasing removes only that action
+  {
+    action_set s{action_type::none, action_type::brake};
+    assert(s.erase(action_type::none) == 1);
+    assert(s.erase(action_type::none) == 0);
+    assert(s.count(action_type::brake));
+    assert(s.size() == 1);
+  }
+  // Clearing removes all actions
+  {
+    action_set s{action_type::shoot, action_type::shoot_stun_rocket};
+    s.clear();
+    assert(s.empty());
+  }
+  // Sets with the same actions are equal
+  {
+    const action_set a{action_type::turn_left, action_type::shoot};
+    const action_set b{action_type::shoot, action_type::turn_left};
+    const action_set c{action_type::shoot};
+    assert(a == b);
+    assert(a != c);
+  }
+  // A set can be stored as bits
+  {
+    const action_set a{action_type::brake, action_type::shoot};
+    action_set b;
+    b.set_bits(a.get_bits());
+    assert(a == b);
+  }
+  // Iteration is in the same order as a std::set
+  {
+    const std::vector<action_type> actions{
+      action_type::shoot_stun_rocket,
+      action_type::turn_left,
+      action_type::none,
+      action_type::accelerate,
+      action_type::acc_backward
+    };
+    action_set s;
+    std::set<action_type> expected;
+    for (const auto action : actions)
+      {
+        s.insert(action);
+        expected.insert(action);
+      }
+    assert(std::vector<action_type>(s.begin(), s.end())
+           == std::vector<action_type>(expected.begin(), expected.end()));
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,86 @@
+#ifndef ACTION_SET_H
+#define ACTION_SET_H
+
+#include "action_type.h"
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+
+/// The set of actions of a player, stored as the bits of an integer.
+/// It behaves like a std::set<action_type>, yet never allocates.
+/// Iteration goes in the order of the action_type values
+class action_set
+{
+public:
+  /// Iterates over the actions in the set
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef action_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const action_type* pointer;
+    typedef action_type reference;
+
+    explicit const_iterator(const unsigned int bits = 0) noexcept : m_bits{bits} {}
+
+    /// Get the action with the lowest value that is left
+    action_type operator*() const noexcept;
+
+    /// Go to the next action
+    const_iterator& operator++() noexcept;
+    const_iterator operator++(int) noexcept;
+
+    bool operator==(const const_iterator& rhs) const noexcept { return m_bits == rhs.m_bits; }
+    bool operator!=(const const_iterator& rhs) const noexcept { return m_bits != rhs.m_bits; }
+
+  private:
+    /// The actions that are left
+    unsigned int m_bits;
+  };
+
+  action_set() noexcept : m_bits{0} {}
+  action_set(std::initializer_list<action_type> actions) noexcept;
+
+  /// Add an action, does nothing if the action is already in the set
+  void insert(const action_type action) noexcept { m_bits |= to_bit(action); }
+
+  /// Remove an action, returns the number of actions removed
+  std::size_t erase(const action_type action) noexcept;
+
+  /// Count the number of times an action is in the set, which is zero or one
+  std::size_t count(const action_type action) const noexcept { return (m_bits & to_bit(action)) ? 1 : 0; }
+
+  bool empty() const noexcept { return m_bits == 0; }
+
+  /// The number of actions in the set
+  std::size_t size() const noexcept;
+
+  void clear() noexcept { m_bits = 0; }
+
+  const_iterator begin() const noexcept { return const_iterator(m_bits); }
+  const_iterator end() const noexcept { return const_iterator(0); }
+
+  /// Get the set as bits, bit i is set if the action with value i is in the set
+  unsigned int get_bits() const noexcept { return m_bits; }
+
+  /// Set the set from bits, bit i is set if the action with value i is in the set
+  void set_bits(const unsigned int bits) noexcept { m_bits = bits; }
+
+private:
+  unsigned int m_bits;
+
+  /// Get the bit of an action
+  static unsigned int to_bit(const action_type action) noexcept
+  {
+    return 1u << static_cast<unsigned int>(action);
+  }
+};
+
+bool operator==(const action_set& lhs, const action_set& rhs) noexcept;
+bool operator!=(const action_set& lhs, const action_set& rhs) noexcept;
+
+/// Test the action_set class
+void test_action_set();
+
+#endif // ACTION_SET_H
@@ -0,0 +1,101 @@
+#include "background_layer.h"
+
+#ifndef LOGIC_ONLY // that is, not compiled on GitHub Actions
+
+#include <cassert>
+
+background_layer::background_layer():
+  m_vertices(sf::Triangles, 6),
+  m_texture{nullptr},
+  m_min_x{0.0},
+  m_min_y{0.0},
+  m_max_x{0.0},
+  m_max_y{0.0},
+  m_n_builds{0}
+{
+}
+
+bool background_layer::update(const environment& e,
+                              const sf::Texture& texture,
+                              const sf::Vector2u& window_size)
+{
+  if (m_texture == &texture
+      && m_texture_size == texture.getSize()
+      && m_window_size == window_size
+      && m_min_x == get_min_x(e)
+      && m_min_y == get_min_y(e)
+      && m_max_x == get_max_x(e)
+      && m_max_y == get_max_y(e))
+    {
+      return false;
+    }
+  m_texture = &texture;
+  m_texture_size = texture.getSize();
+  m_window_size = window_size;
+  m_min_x = get_min_x(e);
+  m_min_y = get_min_y(e);
+  m_max_x = get_max_x(e);
+  m_max_y = get_max_y(e);
+
+  // The texture is stretched over the environment, from
+  // the same corner at (10, 10) the background sprite was drawn at
+  const float left{10.0f};
+  const float top{10.0f};
+  const float right{left + static_cast<float>(m_max_x)};
+  const float bottom{top + static_cast<float>(m_max_y)};
+  const float u{static_cast<float>(m_texture_size.x)};
+  const float v{static_cast<float>(m_texture_size.y)};
+  m_vertices[0] = sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(0.0f, 0.0f));
+  m_vertices[1] = sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(u, 0.0f));
+  m_vertices[2] = sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(u, v));
+  m_vertices[3] = sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(0.0f, 0.0f));
+  m_vertices[4] = sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(u, v));
+  m_vertices[5] = sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(0.0f, v));
+  ++m_n_builds;
+  return true;
+}
+
+void background_layer::draw(sf::RenderTarget& target) const
+{
+  if (!m_texture) return;
+  target.draw(m_vertices, sf::RenderStates(m_texture));
+}
+
+void test_background_layer() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  sf::Texture texture;
+  texture.create(64, 32);
+  const environment e;
+  // A new background layer is built upon its first update only
+  {
+    background_layer b;
+    assert(b.get_n_builds() == 0);
+    assert(b.update(e, texture, sf::Vector2u(1280, 720)));
+    assert(!b.update(e, texture, sf::Vector2u(1280, 720)));
+    assert(b.get_n_builds() == 1);
+  }
+  // The quad covers the environment and all of the texture
+  {
+    background_layer b;
+    b.update(e, texture, sf::Vector2u(1280, 720));
+    const sf::VertexArray& v = b.get_vertices();
+    assert(v.getVertexCount() == 6);
+    assert(v[0].position == sf::Vector2f(10.0f, 10.0f));
+    assert(v[2].position == sf::Vector2f(10.0f + static_cast<float>(get_max_x(e)),
+                                         10.0f + static_cast<float>(get_max_y(e))));
+    assert(v[0].texCoords == sf::Vector2f(0.0f, 0.0f));
+    assert(v[2].texCoords == sf::Vector2f(64.0f, 32.0f));
+  }
+  // A resized window or another environment rebuilds the quad
+  {
+    background_layer b;
+    b.update(e, texture, sf::Vector2u(1280, 720));
+    assert(b.update(e, texture, sf::Vector2u(800, 600)));
+    assert(b.update(environment(500.0), texture, sf::Vector2u(800, 600)));
+    assert(b.get_n_builds() == 3);
+  }
+#endif // no tests in release
+}
+
+#endif // LOGIC_ONLY // that is, not compiled on GitHub Actions
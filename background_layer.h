@@ -0,0 +1,63 @@
+#ifndef BACKGROUND_LAYER_H
+#define BACKGROUND_LAYER_H
+
+#ifndef LOGIC_ONLY // that is, not compiled on GitHub Actions
+
+#include "environment.h"
+#include <SFML/Graphics.hpp>
+
+/// The background of the game, a textured quad that covers
+/// the environment. The quad is built once and only rebuilt
+/// when the environment, the texture or the window size changes,
+/// so drawing it each frame does not copy or upload the texture
+class background_layer
+{
+public:
+  background_layer();
+
+  /// Build the quad for an environment, texture and window size,
+  /// unless it was built for these already.
+  /// The texture must outlive the background layer.
+  /// @return true if the quad was (re)built
+  bool update(const environment& e,
+              const sf::Texture& texture,
+              const sf::Vector2u& window_size);
+
+  /// Draw the quad, in the coordinates of the environment
+  void draw(sf::RenderTarget& target) const;
+
+  /// The vertices of the quad, as two triangles
+  const sf::VertexArray& get_vertices() const noexcept { return m_vertices; }
+
+  /// The number of times the quad was built
+  int get_n_builds() const noexcept { return m_n_builds; }
+
+private:
+  /// The quad, as two triangles
+  sf::VertexArray m_vertices;
+
+  /// The texture of the quad, nullptr if not built yet
+  const sf::Texture* m_texture;
+
+  /// The texture size the quad was built for
+  sf::Vector2u m_texture_size;
+
+  /// The window size the quad was built for
+  sf::Vector2u m_window_size;
+
+  /// The environment corners the quad was built for
+  double m_min_x;
+  double m_min_y;
+  double m_max_x;
+  double m_max_y;
+
+  /// The number of times the quad was built
+  int m_n_builds;
+};
+
+/// Test the background layer
+void test_background_layer();
+
+#endif // LOGIC_ONLY // that is, not compiled on GitHub Actions
+
+#endif // BACKGROUND_LAYER_H
@@ -0,0 +1,208 @@
+#include "binary_io.h"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+void binary_writer::put_varint(std::uint64_t x)
+{
+  while (x >= 0x80)
+    {
+      m_bytes.push_back(static_cast<std::uint8_t>(x | 0x80));
+      x >>= 7;
+    }
+  m_bytes.push_back(static_cast<std::uint8_t>(x));
+}
+
+void binary_writer::put_signed_varint(const std::int64_t x)
+{
+  // Zigzag: 0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...
+  const std::uint64_t u{static_cast<std::uint64_t>(x)};
+  put_varint((u << 1) ^ (x < 0 ? ~std::uint64_t(0) : 0));
+}
+
+void binary_writer::put_u64(const std::uint64_t x)
+{
+  for (int i = 0; i != 8; ++i)
+    {
+      m_bytes.push_back(static_cast<std::uint8_t>(x >> (8 * i)));
+    }
+}
+
+void binary_writer::put_double(const double x)
+{
+  static_assert(sizeof(double) == sizeof(std::uint64_t), "A double must have 64 bits");
+  std::uint64_t u{0};
+  std::memcpy(&u, &x, sizeof(u));
+  put_u64(u);
+}
+
+void binary_writer::put_bytes(const void* data, const std::size_t n_bytes)
+{
+  const std::uint8_t* const p{static_cast<const std::uint8_t*>(data)};
+  m_bytes.insert(std::end(m_bytes), p, p + n_bytes);
+}
+
+binary_reader::binary_reader(const std::uint8_t* begin, const std::size_t n_bytes) noexcept:
+  m_position{begin},
+  m_end{begin + n_bytes}
+{
+}
+
+binary_reader::binary_reader(const std::vector<std::uint8_t>& bytes) noexcept:
+  binary_reader(bytes.data(), bytes.size())
+{
+}
+
+std::uint64_t binary_reader::get_varint()
+{
+  std::uint64_t x{0};
+  for (int shift = 0; shift < 64; shift += 7)
+    {
+      if (m_position == m_end)
+        {
+          throw std::invalid_argument("Binary data ends within a number");
+        }
+      const std::uint8_t byte{*m_position++};
+      x |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return x;
+    }
+  throw std::invalid_argument("Binary data has a number that is too long");
+}
+
+std::uint64_t binary_reader::get_varint(const std::uint64_t max)
+{
+  const std::uint64_t x{get_varint()};
+  if (x > max)
+    {
+      throw std::invalid_argument("Binary data has a number that is too big");
+    }
+  return x;
+}
+
+std::int64_t binary_reader::get_signed_varint()
+{
+  const std::uint64_t u{get_varint()};
+  return static_cast<std::int64_t>((u >> 1) ^ (~(u & 1) + 1));
+}
+
+std::uint64_t binary_reader::get_u64()
+{
+  if (get_n_bytes_left() < 8)
+    {
+      throw std::invalid_argument("Binary data ends within a number");
+    }
+  std::uint64_t x{0};
+  for (int i = 0; i != 8; ++i)
+    {
+      x |= static_cast<std::uint64_t>(*m_position++) << (8 * i);
+    }
+  return x;
+}
+
+double binary_reader::get_double()
+{
+  const std::uint64_t u{get_u64()};
+  double x{0.0};
+  std::memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+void binary_reader::get_bytes(void* data, const std::size_t n_bytes)
+{
+  const std::uint8_t* const begin{m_position};
+  skip(n_bytes);
+  std::memcpy(data, begin, n_bytes);
+}
+
+void binary_reader::skip(const std::size_t n_bytes)
+{
+  if (get_n_bytes_left() < n_bytes)
+    {
+      throw std::invalid_argument("Binary data ends too early");
+    }
+  m_position += n_bytes;
+}
+
+std::size_t binary_reader::get_n_bytes_left() const noexcept
+{
+  return static_cast<std::size_t>(m_end - m_position);
+}
+
+void test_binary_io() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // Small numbers take one byte
+  {
+    binary_writer w;
+    w.put_varint(0);
+    w.put_varint(127);
+    w.put_signed_varint(-64);
+    assert(w.get_bytes().size() == 3);
+    w.put_varint(128);
+    assert(w.get_bytes().size() == 5);
+  }
+  // What is written can be read back
+  {
+    const std::vector<std::uint64_t> us{0, 1, 127, 128, 300, 1ull << 35, UINT64_MAX};
+    const std::vector<std::int64_t> is{0, -1, 1, -300, 300, INT64_MIN, INT64_MAX};
+    const std::vector<double> ds{0.0, -0.0, 1.5, -1.0e300, 3.14159};
+    binary_writer w;
+    for (const auto u : us) w.put_varint(u);
+    for (const auto i : is) w.put_signed_varint(i);
+    for (const auto d : ds) w.put_double(d);
+    w.put_u64(0x0123456789ABCDEFull);
+    w.put_bytes("abc", 3);
+
+    binary_reader r(w.get_bytes());
+    for (const auto u : us) assert(r.get_varint() == u);
+    for (const auto i : is) assert(r.get_signed_varint() == i);
+    for (const auto d : ds) assert(r.get_double() == d);
+    assert(r.get_u64() == 0x0123456789ABCDEFull);
+    char abc[3];
+    r.get_bytes(abc, 3);
+    assert(std::memcmp(abc, "abc", 3) == 0);
+    assert(r.is_done());
+  }
+  // Fixed-size numbers are little endian
+  {
+    binary_writer w;
+    w.put_u64(1);
+    assert(w.get_bytes()[0] == 1);
+    assert(w.get_bytes()[7] == 0);
+  }
+  // Reading past the end throws
+  {
+    binary_writer w;
+    w.put_varint(1000);
+    w.get_bytes().pop_back();
+    binary_reader r(w.get_bytes());
+    bool has_thrown{false};
+    try
+    {
+      r.get_varint();
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+  // A too big number is rejected
+  {
+    binary_writer w;
+    w.put_varint(10);
+    binary_reader r(w.get_bytes());
+    bool has_thrown{false};
+    try
+    {
+      r.get_varint(9);
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+#endif // no tests in release
+}
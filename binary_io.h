@@ -0,0 +1,74 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Writes numbers to a growing buffer of bytes, in a format that
+/// is the same on all machines: integers as varints (seven bits per
+/// byte, lowest bits first) and fixed-size numbers as little endian
+class binary_writer
+{
+public:
+  /// Append an unsigned integer, small values take fewer bytes
+  void put_varint(std::uint64_t x);
+
+  /// Append a signed integer, small absolute values take fewer bytes
+  void put_signed_varint(const std::int64_t x);
+
+  /// Append eight bytes
+  void put_u64(const std::uint64_t x);
+
+  /// Append a double, bit for bit
+  void put_double(const double x);
+
+  /// Append raw bytes
+  void put_bytes(const void* data, const std::size_t n_bytes);
+
+  const std::vector<std::uint8_t>& get_bytes() const noexcept { return m_bytes; }
+  std::vector<std::uint8_t>& get_bytes() noexcept { return m_bytes; }
+
+private:
+  std::vector<std::uint8_t> m_bytes;
+};
+
+/// Reads numbers written by a binary_writer from a range of bytes,
+/// that it does not own. Reading past the end
+/// throws std::invalid_argument
+class binary_reader
+{
+public:
+  binary_reader(const std::uint8_t* begin, const std::size_t n_bytes) noexcept;
+  explicit binary_reader(const std::vector<std::uint8_t>& bytes) noexcept;
+
+  std::uint64_t get_varint();
+  std::int64_t get_signed_varint();
+  std::uint64_t get_u64();
+  double get_double();
+  void get_bytes(void* data, const std::size_t n_bytes);
+
+  /// Get a varint that must be at most 'max', else
+  /// throws std::invalid_argument
+  std::uint64_t get_varint(const std::uint64_t max);
+
+  /// Get the bytes that have not been read yet
+  const std::uint8_t* get_position() const noexcept { return m_position; }
+
+  /// Skip bytes, throws std::invalid_argument if there are not enough left
+  void skip(const std::size_t n_bytes);
+
+  /// The number of bytes left to read
+  std::size_t get_n_bytes_left() const noexcept;
+
+  bool is_done() const noexcept { return m_position == m_end; }
+
+private:
+  const std::uint8_t* m_position;
+  const std::uint8_t* m_end;
+};
+
+/// Test the binary_writer and binary_reader classes
+void test_binary_io();
+
+#endif // BINARY_IO_H
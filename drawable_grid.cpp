@@ -0,0 +1,104 @@
+#include "drawable_grid.h"
+
+#include <algorithm>
+#include <cassert>
+
+drawable_grid::drawable_grid():
+  m_max_reach{0.0}
+{
+}
+
+void drawable_grid::clear() noexcept
+{
+  m_xs.clear();
+  m_ys.clear();
+  m_reaches.clear();
+  m_max_reach = 0.0;
+}
+
+void drawable_grid::add(const double x, const double y, const double reach)
+{
+  assert(reach >= 0.0);
+  m_xs.push_back(x);
+  m_ys.push_back(y);
+  m_reaches.push_back(reach);
+  m_max_reach = std::max(m_max_reach, reach);
+}
+
+void drawable_grid::build(const coordinate& top_left, const coordinate& bottom_right)
+{
+  m_grid.rebuild(top_left, bottom_right, get_cell_size(), m_xs, m_ys);
+}
+
+void drawable_grid::query(const double min_x,
+                          const double min_y,
+                          const double max_x,
+                          const double max_y,
+                          std::vector<int>& indices) const
+{
+  assert(m_grid.get_n_items() == get_n_items());
+  // A thing in a cell outside of the rectangle can reach into it
+  m_candidates.clear();
+  m_grid.query(min_x - m_max_reach, min_y - m_max_reach,
+               max_x + m_max_reach, max_y + m_max_reach,
+               m_candidates);
+  for (const int i : m_candidates)
+    {
+      const double reach{m_reaches[i]};
+      if (m_xs[i] + reach >= min_x && m_xs[i] - reach <= max_x
+          && m_ys[i] + reach >= min_y && m_ys[i] - reach <= max_y)
+        {
+          indices.push_back(i);
+        }
+    }
+}
+
+void test_drawable_grid() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  const coordinate top_left(0.0, 0.0);
+  const coordinate bottom_right(2000.0, 1000.0);
+  // An empty grid has nothing to draw
+  {
+    drawable_grid g;
+    g.build(top_left, bottom_right);
+    std::vector<int> indices;
+    g.query(0.0, 0.0, 2000.0, 1000.0, indices);
+    assert(indices.empty());
+  }
+  // Only the things that overlap with the rectangle are found, in order
+  {
+    drawable_grid g;
+    g.add(100.0, 100.0, 10.0);   // Inside
+    g.add(1500.0, 800.0, 10.0);  // Far away
+    g.add(520.0, 300.0, 30.0);   // Reaches into the rectangle
+    g.add(550.0, 300.0, 30.0);   // Does not reach into the rectangle
+    g.add(-100.0, 100.0, 10.0);  // Outside of the grid, and inside the rectangle
+    g.build(top_left, bottom_right);
+    std::vector<int> indices;
+    g.query(-200.0, 0.0, 500.0, 400.0, indices);
+    assert(indices == std::vector<int>({0, 2, 4}));
+  }
+  // A thing with a big reach is found from far away
+  {
+    drawable_grid g;
+    g.add(1000.0, 500.0, 600.0);
+    g.add(1000.0, 500.0, 10.0);
+    g.build(top_left, bottom_right);
+    std::vector<int> indices;
+    g.query(0.0, 0.0, 410.0, 100.0, indices);
+    assert(indices == std::vector<int>({0}));
+  }
+  // Clearing removes all things
+  {
+    drawable_grid g;
+    g.add(100.0, 100.0, 10.0);
+    g.clear();
+    g.build(top_left, bottom_right);
+    assert(g.get_n_items() == 0);
+    std::vector<int> indices;
+    g.query(0.0, 0.0, 2000.0, 1000.0, indices);
+    assert(indices.empty());
+  }
+#endif // no tests in release
+}
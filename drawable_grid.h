@@ -0,0 +1,60 @@
+#ifndef DRAWABLE_GRID_H
+#define DRAWABLE_GRID_H
+
+#include "coordinate.h"
+#include "spatial_grid.h"
+#include <vector>
+
+/// A spatial index over the things to draw, to find the things
+/// a view can see without checking all things.
+/// Each thing has a position and a reach: all of it is drawn
+/// within that distance from its position, horizontally and vertically
+class drawable_grid
+{
+public:
+  drawable_grid();
+
+  /// Remove all things, keeping the memory
+  void clear() noexcept;
+
+  /// Add a thing, which gets the next index
+  void add(const double x, const double y, const double reach);
+
+  /// Put the added things in the grid,
+  /// which covers the rectangle between two corners
+  void build(const coordinate& top_left, const coordinate& bottom_right);
+
+  /// Get the things that overlap with a rectangle, in increasing order
+  /// of index. These are appended to 'indices'
+  void query(const double min_x,
+             const double min_y,
+             const double max_x,
+             const double max_y,
+             std::vector<int>& indices) const;
+
+  /// The number of things added
+  int get_n_items() const noexcept { return static_cast<int>(m_xs.size()); }
+
+  /// The width and height of a cell, a view should
+  /// span a few cells only
+  static double get_cell_size() noexcept { return 200.0; }
+
+private:
+  std::vector<double> m_xs;
+  std::vector<double> m_ys;
+  std::vector<double> m_reaches;
+
+  /// The biggest reach of all things
+  double m_max_reach;
+
+  /// The grid with the positions of all things
+  spatial_grid m_grid;
+
+  /// The things in the cells that overlap with a rectangle
+  mutable std::vector<int> m_candidates;
+};
+
+/// Test the drawable grid
+void test_drawable_grid();
+
+#endif // DRAWABLE_GRID_H
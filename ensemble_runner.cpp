@@ -0,0 +1,288 @@
+#include "ensemble_runner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+ensemble_options::ensemble_options(const headless_options& game_options,
+                                   const int n_games,
+                                   const int n_threads):
+  m_game_options{game_options},
+  m_n_games{n_games},
+  m_n_threads{n_threads}
+{
+  if (m_n_games < 0 || m_n_threads < 0)
+    {
+      throw std::invalid_argument("Ensemble options cannot be negative");
+    }
+  if (m_n_threads == 0)
+    {
+      // Can be zero if the number of cores is unknown
+      m_n_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+ensemble_options parse_ensemble_args(const std::vector<std::string>& args)
+{
+  const ensemble_options defaults;
+  int n_games = defaults.get_n_games();
+  int n_threads = 0;
+
+  // Take out the ensemble flags, leave the rest to the headless runner
+  std::vector<std::string> game_args;
+  if (!args.empty()) game_args.push_back(args[0]);
+  for (std::size_t i = 1; i < args.size(); ++i)
+    {
+      const std::string& flag = args[i];
+      if ((flag == "--games" || flag == "--threads") && i + 1 < args.size())
+        {
+          const int value = to_int(flag, args[i + 1]);
+          if (flag == "--games") n_games = value;
+          else n_threads = value;
+          ++i;
+        }
+      else
+        {
+          game_args.push_back(flag);
+        }
+    }
+  return ensemble_options(parse_headless_args(game_args), n_games, n_threads);
+}
+
+ensemble_result::ensemble_result(const int seed,
+                                 const int n_alive_players,
+                                 const double mean_player_diameter,
+                                 const int n_projectiles):
+  m_seed{seed},
+  m_n_alive_players{n_alive_players},
+  m_mean_player_diameter{mean_player_diameter},
+  m_n_projectiles{n_projectiles}
+{
+}
+
+ensemble_result run_ensemble_game(const headless_options& options)
+{
+  game g = create_headless_game(options);
+  for (int tick = 0; tick != options.get_n_ticks(); ++tick)
+    {
+      apply_scripted_actions(g, tick);
+      g.tick();
+    }
+  std::vector<double> diameters;
+  for (const auto& p : g.get_v_player())
+    {
+      diameters.push_back(p.get_diameter());
+    }
+  return ensemble_result(
+    options.get_seed(),
+    count_alive_players(g),
+    diameters.empty() ? 0.0 : calc_mean(diameters),
+    count_n_projectiles(g)
+  );
+}
+
+/// The games a thread still has to play, other threads can steal from it
+struct ensemble_queue
+{
+  std::mutex m_mutex;
+  std::deque<int> m_games;
+};
+
+/// Take a game from the back of a thread's own queue,
+/// returns -1 if the queue is empty
+static int pop_own_game(ensemble_queue& q)
+{
+  std::lock_guard<std::mutex> lock(q.m_mutex);
+  if (q.m_games.empty()) return -1;
+  const int game_index{q.m_games.back()};
+  q.m_games.pop_back();
+  return game_index;
+}
+
+/// Take a game from the front of another thread's queue,
+/// returns -1 if the queue is empty
+static int steal_game(ensemble_queue& q)
+{
+  std::lock_guard<std::mutex> lock(q.m_mutex);
+  if (q.m_games.empty()) return -1;
+  const int game_index{q.m_games.front()};
+  q.m_games.pop_front();
+  return game_index;
+}
+
+ensemble_runner::ensemble_runner(const ensemble_options& options):
+  m_options{options},
+  m_results(static_cast<std::size_t>(options.get_n_games())),
+  m_n_games_per_thread(static_cast<std::size_t>(options.get_n_threads()), 0),
+  m_duration{0.0}
+{
+}
+
+void ensemble_runner::run()
+{
+  const int n_threads{m_options.get_n_threads()};
+  const int n_games{m_options.get_n_games()};
+  const headless_options& o = m_options.get_game_options();
+
+  // Give each thread an equal share of the games to start with
+  std::vector<std::unique_ptr<ensemble_queue>> queues;
+  for (int t = 0; t != n_threads; ++t)
+    {
+      queues.push_back(std::unique_ptr<ensemble_queue>(new ensemble_queue));
+    }
+  for (int i = 0; i != n_games; ++i)
+    {
+      queues[static_cast<std::size_t>(static_cast<long long>(i) * n_threads / std::max(n_games, 1))]->m_games.push_back(i);
+    }
+
+  // Each game writes to its own result, so the results need no lock
+  const auto work = [&](const int t)
+  {
+    int n_played{0};
+    while (true)
+      {
+        int game_index{pop_own_game(*queues[t])};
+        for (int i = 1; game_index == -1 && i != n_threads; ++i)
+          {
+            game_index = steal_game(*queues[(t + i) % n_threads]);
+          }
+        if (game_index == -1) break;
+        const headless_options game_options(
+          o.get_n_players(), o.get_n_food(), o.get_n_shelters(),
+          o.get_n_projectiles(), o.get_seed() + game_index, o.get_n_ticks()
+        );
+        m_results[game_index] = run_ensemble_game(game_options);
+        ++n_played;
+      }
+    m_n_games_per_thread[t] = n_played;
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 1; t < n_threads; ++t)
+    {
+      threads.push_back(std::thread(work, t));
+    }
+  work(0);
+  for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  const auto end = std::chrono::steady_clock::now();
+  m_duration = std::chrono::duration<double>(end - start).count();
+}
+
+double ensemble_runner::get_games_per_second() const noexcept
+{
+  if (m_duration <= 0.0) return 0.0;
+  return static_cast<double>(m_options.get_n_games()) / m_duration;
+}
+
+void write_ensemble_report(std::ostream& os, const ensemble_runner& r)
+{
+  const ensemble_options& o = r.get_options();
+  const headless_options& g = o.get_game_options();
+  std::vector<double> n_alive;
+  std::vector<double> diameters;
+  std::vector<double> n_projectiles;
+  for (const auto& result : r.get_results())
+    {
+      n_alive.push_back(result.get_n_alive_players());
+      diameters.push_back(result.get_mean_player_diameter());
+      n_projectiles.push_back(result.get_n_projectiles());
+    }
+  os << "games: " << o.get_n_games()
+     << ", threads: " << o.get_n_threads() << '\n'
+     << "players: " << g.get_n_players()
+     << ", food: " << g.get_n_food()
+     << ", shelters: " << g.get_n_shelters()
+     << ", projectiles: " << g.get_n_projectiles()
+     << ", first seed: " << g.get_seed()
+     << ", ticks: " << g.get_n_ticks() << '\n'
+     << "games/second: " << r.get_games_per_second() << '\n';
+  if (r.get_results().empty()) return;
+  os << "alive players: mean " << calc_mean(n_alive)
+     << ", variance " << calc_var(n_alive) << '\n'
+     << "player diameter: mean " << calc_mean(diameters)
+     << ", variance " << calc_var(diameters) << '\n'
+     << "projectiles at end: mean " << calc_mean(n_projectiles)
+     << ", variance " << calc_var(n_projectiles) << '\n';
+}
+
+void test_ensemble_runner() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // By default, all cores are used
+  {
+    const ensemble_options o;
+    assert(o.get_n_threads() >= 1);
+    assert(o.get_n_games() == 100);
+  }
+  // Options are read from the command line, the others go to the games
+  {
+    const ensemble_options o = parse_ensemble_args(
+      {"path", "--games", "10", "--players", "4", "--threads", "2"}
+    );
+    assert(o.get_n_games() == 10);
+    assert(o.get_n_threads() == 2);
+    assert(o.get_game_options().get_n_players() == 4);
+  }
+  // Bad values are rejected
+  {
+    bool has_thrown{false};
+    try
+    {
+      parse_ensemble_args({"path", "--games", "many"});
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+  // All games are played once, whatever the number of threads,
+  // and the outcome does not depend on the number of threads
+  {
+    const headless_options game_options(3, 2, 5, 2, 10, 50);
+    ensemble_runner one(ensemble_options(game_options, 7, 1));
+    ensemble_runner three(ensemble_options(game_options, 7, 3));
+    one.run();
+    three.run();
+    int n_played{0};
+    for (const int n : three.get_n_games_per_thread()) n_played += n;
+    assert(n_played == 7);
+    assert(one.get_n_games_per_thread()[0] == 7);
+    for (int i = 0; i != 7; ++i)
+      {
+        assert(one.get_results()[i].get_seed() == 10 + i);
+        assert(three.get_results()[i].get_seed() == 10 + i);
+        assert(one.get_results()[i].get_mean_player_diameter()
+               == three.get_results()[i].get_mean_player_diameter());
+        assert(one.get_results()[i].get_n_alive_players()
+               == three.get_results()[i].get_n_alive_players());
+      }
+    assert(one.get_games_per_second() > 0.0);
+  }
+  // More threads than games
+  {
+    ensemble_runner r(ensemble_options(headless_options(3, 1, 0, 0, 0, 10), 2, 4));
+    r.run();
+    assert(r.get_results().size() == 2);
+  }
+  // A report can be written
+  {
+    ensemble_runner r(ensemble_options(headless_options(3, 1, 0, 0, 0, 10), 3, 2));
+    r.run();
+    std::stringstream s;
+    write_ensemble_report(s, r);
+    assert(!s.str().empty());
+  }
+#endif // no tests in release
+}
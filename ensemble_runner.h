@@ -0,0 +1,103 @@
+#ifndef ENSEMBLE_RUNNER_H
+#define ENSEMBLE_RUNNER_H
+
+#include "headless_runner.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// The settings of an ensemble: many independent headless games
+class ensemble_options
+{
+public:
+  /// @param game_options the settings of each game. Game i uses
+  ///   the seed of these options plus i
+  /// @param n_games the number of games
+  /// @param n_threads the number of threads, zero to use all cores
+  ensemble_options(const headless_options& game_options = headless_options(),
+                   const int n_games = 100,
+                   const int n_threads = 0);
+
+  const headless_options& get_game_options() const noexcept { return m_game_options; }
+  int get_n_games() const noexcept { return m_n_games; }
+
+  /// The number of threads, which is at least one
+  int get_n_threads() const noexcept { return m_n_threads; }
+
+private:
+  headless_options m_game_options;
+  int m_n_games;
+  int m_n_threads;
+};
+
+/// Read the ensemble options from the command-line arguments,
+/// which are those of the headless runner plus '--games' and '--threads',
+/// e.g. {"path", "--games", "1000", "--ticks", "500"}.
+/// Throws std::invalid_argument upon an unknown flag or a bad value
+ensemble_options parse_ensemble_args(const std::vector<std::string>& args);
+
+/// The outcome of one game of an ensemble
+class ensemble_result
+{
+public:
+  ensemble_result(const int seed = 0,
+                  const int n_alive_players = 0,
+                  const double mean_player_diameter = 0.0,
+                  const int n_projectiles = 0);
+
+  int get_seed() const noexcept { return m_seed; }
+  int get_n_alive_players() const noexcept { return m_n_alive_players; }
+  double get_mean_player_diameter() const noexcept { return m_mean_player_diameter; }
+  int get_n_projectiles() const noexcept { return m_n_projectiles; }
+
+private:
+  int m_seed;
+  int m_n_alive_players;
+  double m_mean_player_diameter;
+  int m_n_projectiles;
+};
+
+/// Play one game of an ensemble, with scripted actions, and get its outcome
+ensemble_result run_ensemble_game(const headless_options& options);
+
+/// Runs many independent games on all cores.
+/// Each thread has a queue of games to play. A thread that has
+/// played all its games takes games from the front of the queue of
+/// another thread, while that thread plays the games at the back,
+/// so that all threads keep working until the end
+class ensemble_runner
+{
+public:
+  explicit ensemble_runner(const ensemble_options& options);
+
+  /// Play all games
+  void run();
+
+  const ensemble_options& get_options() const noexcept { return m_options; }
+
+  /// The outcome of each game, in the order of their seeds
+  const std::vector<ensemble_result>& get_results() const noexcept { return m_results; }
+
+  /// The number of games played per second
+  double get_games_per_second() const noexcept;
+
+  /// The number of games each thread played
+  const std::vector<int>& get_n_games_per_thread() const noexcept { return m_n_games_per_thread; }
+
+private:
+  ensemble_options m_options;
+  std::vector<ensemble_result> m_results;
+  std::vector<int> m_n_games_per_thread;
+
+  /// The duration of 'run', in seconds
+  double m_duration;
+};
+
+/// Write the throughput and the mean and variance of the
+/// outcomes of a finished ensemble
+void write_ensemble_report(std::ostream& os, const ensemble_runner& r);
+
+/// Test the ensemble runner
+void test_ensemble_runner();
+
+#endif // ENSEMBLE_RUNNER_H
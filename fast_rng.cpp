@@ -0,0 +1,123 @@
+#include "fast_rng.h"
+#include <cassert>
+#include <cmath>
+#include <random>
+
+/// Get the next number of a splitmix64 sequence,
+/// used to turn a seed into a good initial state
+static std::uint64_t splitmix64(std::uint64_t& x) noexcept
+{
+  x += 0x9E3779B97F4A7C15ull;
+  std::uint64_t z{x};
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static std::uint64_t rotate_left(const std::uint64_t x, const int k) noexcept
+{
+  return (x << k) | (x >> (64 - k));
+}
+
+fast_rng::fast_rng(const std::uint64_t seed, const std::uint64_t stream) noexcept
+{
+  // Mix the stream into the seed, so that each stream starts elsewhere
+  std::uint64_t x{seed};
+  x ^= splitmix64(x) + stream;
+  for (auto& s : m_state) s = splitmix64(x);
+}
+
+fast_rng::result_type fast_rng::operator()() noexcept
+{
+  const std::uint64_t result{rotate_left(m_state[1] * 5, 7) * 9};
+  const std::uint64_t t{m_state[1] << 17};
+  m_state[2] ^= m_state[0];
+  m_state[3] ^= m_state[1];
+  m_state[1] ^= m_state[2];
+  m_state[0] ^= m_state[3];
+  m_state[2] ^= t;
+  m_state[3] = rotate_left(m_state[3], 45);
+  return result;
+}
+
+double fast_rng::uniform() noexcept
+{
+  // The 53 highest bits fill the mantissa of a double
+  return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double fast_rng::uniform(const double lowest, const double highest) noexcept
+{
+  return lowest + ((highest - lowest) * uniform());
+}
+
+void fast_rng::fill_uniform(std::vector<double>& values) noexcept
+{
+  for (auto& value : values) value = uniform();
+}
+
+void test_fast_rng() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // The same seed and stream give the same numbers
+  {
+    fast_rng a(42, 1);
+    fast_rng b(42, 1);
+    for (int i = 0; i != 100; ++i) assert(a() == b());
+  }
+  // A different seed or stream gives different numbers
+  {
+    fast_rng a(42, 1);
+    fast_rng b(43, 1);
+    fast_rng c(42, 2);
+    const auto x = a();
+    assert(x != b());
+    assert(x != c());
+  }
+  // Uniform numbers are in range and are spread out
+  {
+    fast_rng r(123);
+    double sum{0.0};
+    const int n{10000};
+    for (int i = 0; i != n; ++i)
+      {
+        const double x{r.uniform(-2.0, 3.0)};
+        assert(x >= -2.0);
+        assert(x < 3.0);
+        sum += x;
+      }
+    assert(std::abs((sum / n) - 0.5) < 0.1);
+  }
+  // Filling draws the same numbers as drawing one by one
+  {
+    fast_rng a(7);
+    fast_rng b(7);
+    std::vector<double> v(100);
+    a.fill_uniform(v);
+    for (const double x : v) assert(x == b.uniform());
+    assert(a() == b());
+  }
+  // Works with the standard distributions
+  {
+    fast_rng r;
+    std::uniform_int_distribution<int> d(1, 6);
+    const int x{d(r)};
+    assert(x >= 1 && x <= 6);
+  }
+  // A copy draws the same numbers
+  {
+    fast_rng a(7);
+    a();
+    fast_rng b{a};
+    assert(a() == b());
+  }
+  // A generator continues where another was, after setting its state
+  {
+    fast_rng a(7);
+    a();
+    fast_rng b(8);
+    b.set_state(a.get_state());
+    assert(a() == b());
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,53 @@
+#ifndef FAST_RNG_H
+#define FAST_RNG_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// A fast random number generator (xoshiro256**), for the many
+/// random numbers drawn each tick. Each game has its own generators,
+/// one per part of the game (a 'stream'), so that games are
+/// reproducible from their seed and can run in parallel.
+/// It can be used with the <random> distributions
+class fast_rng
+{
+public:
+  typedef std::uint64_t result_type;
+
+  /// @param seed the seed of the game
+  /// @param stream the part of the game the generator is used for,
+  ///   generators with the same seed and a different stream
+  ///   give different numbers
+  explicit fast_rng(const std::uint64_t seed = 0, const std::uint64_t stream = 0) noexcept;
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept { return UINT64_MAX; }
+
+  /// Draw the next random number
+  result_type operator()() noexcept;
+
+  /// Draw a random number from zero (included) to one (excluded)
+  double uniform() noexcept;
+
+  /// Draw a random number from 'lowest' (included) to 'highest' (excluded)
+  double uniform(const double lowest, const double highest) noexcept;
+
+  /// Fill 'values' with random numbers from zero (included) to one (excluded),
+  /// the same numbers as calling 'uniform()' for each value in turn
+  void fill_uniform(std::vector<double>& values) noexcept;
+
+  /// Get the state, to continue the sequence later with 'set_state'
+  const std::array<std::uint64_t, 4>& get_state() const noexcept { return m_state; }
+
+  /// Set the state, which cannot be all zeroes
+  void set_state(const std::array<std::uint64_t, 4>& state) noexcept { m_state = state; }
+
+private:
+  std::array<std::uint64_t, 4> m_state;
+};
+
+/// Test the fast_rng class
+void test_fast_rng();
+
+#endif // FAST_RNG_H
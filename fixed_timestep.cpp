@@ -0,0 +1,121 @@
+#include "fixed_timestep.h"
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+fixed_timestep::fixed_timestep(const double tick_rate, const int max_n_ticks_per_frame)
+  : m_tick_duration{1.0 / tick_rate},
+    m_max_n_ticks_per_frame{max_n_ticks_per_frame},
+    m_accumulated{0.0}
+{
+  if (!(tick_rate > 0.0))
+    {
+      throw std::invalid_argument("The tick rate must be positive");
+    }
+  if (max_n_ticks_per_frame < 1)
+    {
+      throw std::invalid_argument("There must be at least one tick per frame");
+    }
+}
+
+int fixed_timestep::advance(const double seconds)
+{
+  assert(seconds >= 0.0);
+  m_accumulated += seconds;
+  int n_ticks{0};
+  while (m_accumulated >= m_tick_duration && n_ticks != m_max_n_ticks_per_frame)
+    {
+      m_accumulated -= m_tick_duration;
+      ++n_ticks;
+    }
+  // Too far behind: forget the time that cannot be caught up with
+  if (m_accumulated >= m_tick_duration)
+    {
+      m_accumulated = std::fmod(m_accumulated, m_tick_duration);
+    }
+  return n_ticks;
+}
+
+double interpolate(const double previous, const double current, const double alpha) noexcept
+{
+  return previous + ((current - previous) * alpha);
+}
+
+coordinate interpolate(const coordinate& previous, const coordinate& current, const double alpha) noexcept
+{
+  return coordinate(
+    interpolate(previous.get_x(), current.get_x(), alpha),
+    interpolate(previous.get_y(), current.get_y(), alpha)
+  );
+}
+
+double interpolate_angle(const double previous, const double current, const double alpha) noexcept
+{
+  // The turn from previous to current, from minus pi to pi
+  const double turn{std::remainder(current - previous, 2.0 * M_PI)};
+  return previous + (turn * alpha);
+}
+
+void test_fixed_timestep() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // Default is 60 ticks per second
+  {
+    const fixed_timestep t;
+    assert(std::abs(t.get_tick_rate() - 60.0) < 0.000001);
+    assert(t.get_max_n_ticks_per_frame() == 5);
+    assert(t.get_alpha() == 0.0);
+  }
+  // No ticks are done until a tick's worth of time has passed
+  {
+    fixed_timestep t(10.0);
+    assert(t.advance(0.05) == 0);
+    assert(std::abs(t.get_alpha() - 0.5) < 0.000001);
+    assert(t.advance(0.06) == 1);
+    assert(std::abs(t.get_alpha() - 0.1) < 0.000001);
+  }
+  // A fast machine does fewer ticks than frames,
+  // a slow machine more ticks than frames
+  {
+    fixed_timestep t(100.0, 20);
+    int n_ticks{0};
+    for (int i = 0; i != 1000; ++i) n_ticks += t.advance(1.0 / 1000.0);
+    assert(std::abs(n_ticks - 100) <= 1);
+    n_ticks = 0;
+    for (int i = 0; i != 10; ++i) n_ticks += t.advance(1.0 / 10.0);
+    assert(std::abs(n_ticks - 100) <= 1);
+  }
+  // After a long pause, only the maximum number of ticks is done
+  {
+    fixed_timestep t(60.0, 3);
+    assert(t.advance(10.0) == 3);
+    assert(t.get_alpha() < 1.0);
+    assert(t.advance(0.0) == 0);
+  }
+  // Invalid arguments
+  {
+    bool has_thrown{false};
+    try { fixed_timestep(0.0); } catch (const std::invalid_argument&) { has_thrown = true; }
+    assert(has_thrown);
+    has_thrown = false;
+    try { fixed_timestep(60.0, 0); } catch (const std::invalid_argument&) { has_thrown = true; }
+    assert(has_thrown);
+  }
+  // Interpolation
+  {
+    assert(interpolate(1.0, 3.0, 0.0) == 1.0);
+    assert(interpolate(1.0, 3.0, 0.5) == 2.0);
+    assert(interpolate(1.0, 3.0, 1.0) == 3.0);
+    coordinate c = interpolate(coordinate(0.0, 10.0), coordinate(10.0, 20.0), 0.5);
+    assert(c == coordinate(5.0, 15.0));
+  }
+  // Angles are interpolated along the shortest turn
+  {
+    assert(interpolate_angle(1.0, 2.0, 0.5) == 1.5);
+    assert(interpolate_angle(1.0, 2.0, 0.0) == 1.0);
+    // Turning from just below a full circle to just above zero
+    const double a{interpolate_angle(2.0 * M_PI - 0.1, 0.1, 0.5)};
+    assert(std::abs(std::remainder(a, 2.0 * M_PI)) < 0.000001);
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,62 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include "coordinate.h"
+
+/// Decides how many game ticks to do per frame, so that the game
+/// runs at a fixed number of ticks per second, whatever the frame rate.
+/// The time that passed is accumulated and used up a tick at a time.
+/// On a slow machine, at most a fixed number of ticks is done per frame,
+/// after which the game runs slower instead of trying to catch up forever
+class fixed_timestep
+{
+public:
+  /// @param tick_rate the number of ticks per second
+  /// @param max_n_ticks_per_frame the maximum number of ticks per frame
+  fixed_timestep(const double tick_rate = 60.0, const int max_n_ticks_per_frame = 5);
+
+  /// Add the time that passed since the previous frame, in seconds,
+  /// and get the number of ticks to do in this frame
+  int advance(const double seconds);
+
+  /// Get how far the game is from the latest tick towards the next one,
+  /// from zero to one. Used to interpolate between the
+  /// state before and after the latest tick
+  double get_alpha() const noexcept { return m_accumulated / m_tick_duration; }
+
+  /// Get the number of ticks per second
+  double get_tick_rate() const noexcept { return 1.0 / m_tick_duration; }
+
+  /// Get the duration of a tick, in seconds
+  double get_tick_duration() const noexcept { return m_tick_duration; }
+
+  /// Get the maximum number of ticks per frame
+  int get_max_n_ticks_per_frame() const noexcept { return m_max_n_ticks_per_frame; }
+
+private:
+  /// The duration of a tick, in seconds
+  double m_tick_duration;
+
+  /// The maximum number of ticks per frame
+  int m_max_n_ticks_per_frame;
+
+  /// The time that passed that is not used up by ticks yet, in seconds
+  double m_accumulated;
+};
+
+/// Interpolate between two values, alpha is zero at 'previous'
+/// and one at 'current'
+double interpolate(const double previous, const double current, const double alpha) noexcept;
+
+/// Interpolate between two coordinates, alpha is zero at 'previous'
+/// and one at 'current'
+coordinate interpolate(const coordinate& previous, const coordinate& current, const double alpha) noexcept;
+
+/// Interpolate between two angles in radians, along the shortest turn,
+/// alpha is zero at 'previous' and one at 'current'
+double interpolate_angle(const double previous, const double current, const double alpha) noexcept;
+
+/// Test the fixed_timestep class
+void test_fixed_timestep();
+
+#endif // FIXED_TIMESTEP_H
@@ -43,21 +43,11 @@ bool operator!=(const food& lhs, const food& rhs) noexcept
 }
 
 
-void food::place_randomly(std::mt19937 &rng, const coordinate& top_left, const coordinate& bottom_right)
+void food::place_randomly(fast_rng &rng, const coordinate& top_left, const coordinate& bottom_right)
 {
-  std::uniform_real_distribution<> dis_x(top_left.get_x(), bottom_right.get_x());
-  std::uniform_real_distribution<> dis_y(top_left.get_y(), bottom_right.get_y());
-  m_c = coordinate(dis_x(rng), dis_y(rng));
-}
-
-void food::increment_timer()
-{
-  ++m_timer;
-}
-
-void food::reset_timer()
-{
-  m_timer = 0;
+  const double x{rng.uniform(top_left.get_x(), bottom_right.get_x())};
+  const double y{rng.uniform(top_left.get_y(), bottom_right.get_y())};
+  m_c = coordinate(x, y);
 }
 
 
@@ -150,6 +140,15 @@ void test_food()
     assert(f.get_regeneration_time() == 100);
   }
 
+  //A food's timer runs from when it was last eaten
+  {
+    food f;
+    assert(f.get_timer(10) == 10);
+    f.set_eaten_at(7);
+    assert(f.get_eaten_at() == 7);
+    assert(f.get_timer(10) == 3);
+  }
+
   //A food has a regeneration time
   {
     food f;
@@ -3,9 +3,9 @@
 
 #include "coordinate.h"
 #include "color.h"
+#include "fast_rng.h"
 #include "food_state.h"
 #include <vector>
-#include <random>
 class food
 {
 public:
@@ -21,17 +21,25 @@ public:
   /// Get the food state
   food_state get_food_state() const noexcept { return m_food_state;}
   void set_food_state(const food_state &newState) noexcept { m_food_state = newState; }
-  void place_randomly(std::mt19937 &rng, const coordinate& top_left, const coordinate& bottom_right);
+  void place_randomly(fast_rng &rng, const coordinate& top_left, const coordinate& bottom_right);
+  /// Put the food at a position
+  void set_position(const coordinate& c) noexcept { m_c = c; }
   double get_radius() const noexcept;
-  int get_timer() const noexcept { return m_timer; }
-  void increment_timer();
-  void reset_timer();
+
+  /// Get the value of the game's food clock when the food was last eaten,
+  /// zero if it was never eaten
+  int get_eaten_at() const noexcept { return m_eaten_at; }
+  void set_eaten_at(const int food_clock) noexcept { m_eaten_at = food_clock; }
+
+  /// Get the number of food clock ticks since the food was last eaten,
+  /// or since the food clock started if it was never eaten
+  int get_timer(const int food_clock) const noexcept { return food_clock - m_eaten_at; }
 
 private:
   coordinate m_c;
   color m_color;
   int m_regeneration_time;
-  int m_timer = 0;
+  int m_eaten_at = 0;
   /// the food state
   food_state m_food_state;
   double m_radius;
@@ -0,0 +1,292 @@
+#include "food_grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+food_grid::food_grid():
+  m_min_x{0.0},
+  m_min_y{0.0},
+  m_cell_size{1.0},
+  m_n_cols{1},
+  m_n_rows{1},
+  m_n_items{0},
+  m_max_radius{0.0},
+  m_cells(1)
+{
+}
+
+void food_grid::rebuild(const coordinate& top_left,
+                        const coordinate& bottom_right,
+                        const double cell_size,
+                        const std::vector<food>& food)
+{
+  assert(cell_size > 0.0);
+  const double width{std::max(bottom_right.get_x() - top_left.get_x(), 0.0)};
+  const double height{std::max(bottom_right.get_y() - top_left.get_y(), 0.0)};
+  const int max_n{get_max_n_cells_per_axis()};
+
+  m_min_x = top_left.get_x();
+  m_min_y = top_left.get_y();
+  m_cell_size = std::max(cell_size, std::max(width, height) / max_n);
+  m_n_cols = std::max(1, std::min(max_n, static_cast<int>(std::ceil(width / m_cell_size))));
+  m_n_rows = std::max(1, std::min(max_n, static_cast<int>(std::ceil(height / m_cell_size))));
+
+  // Keep the memory of the cells, these are refilled after a rebuild
+  m_cells.resize(static_cast<std::size_t>(m_n_cols * m_n_rows));
+  for (auto& cell : m_cells) cell.clear();
+  m_cell_of_item.assign(food.size(), -1);
+  m_slot_of_item.assign(food.size(), -1);
+  m_n_items = 0;
+  m_max_radius = 0.0;
+  const int n_food{static_cast<int>(food.size())};
+  for (int i = 0; i != n_food; ++i)
+    {
+      if (!food[i].is_eaten()) insert(i, food[i]);
+    }
+}
+
+void food_grid::insert(const int i, const food& f)
+{
+  assert(i >= 0);
+  erase(i);
+  if (i >= static_cast<int>(m_cell_of_item.size()))
+    {
+      m_cell_of_item.resize(static_cast<std::size_t>(i + 1), -1);
+      m_slot_of_item.resize(static_cast<std::size_t>(i + 1), -1);
+    }
+  const int cell{(get_row(f.get_y()) * m_n_cols) + get_col(f.get_x())};
+  m_cell_of_item[i] = cell;
+  m_slot_of_item[i] = static_cast<int>(m_cells[cell].size());
+  m_cells[cell].push_back(i);
+  m_max_radius = std::max(m_max_radius, f.get_radius());
+  ++m_n_items;
+}
+
+void food_grid::erase(const int i)
+{
+  if (!contains(i)) return;
+  // Move the last item of the cell into the slot of the erased item
+  std::vector<int>& cell = m_cells[m_cell_of_item[i]];
+  const int slot{m_slot_of_item[i]};
+  const int last{cell.back()};
+  cell[slot] = last;
+  m_slot_of_item[last] = slot;
+  cell.pop_back();
+  m_cell_of_item[i] = -1;
+  m_slot_of_item[i] = -1;
+  --m_n_items;
+}
+
+bool food_grid::contains(const int i) const noexcept
+{
+  return i >= 0
+    && i < static_cast<int>(m_cell_of_item.size())
+    && m_cell_of_item[i] != -1;
+}
+
+int food_grid::count_items_at(const double x, const double y) const noexcept
+{
+  return static_cast<int>(m_cells[(get_row(y) * m_n_cols) + get_col(x)].size());
+}
+
+int food_grid::get_col(const double x) const noexcept
+{
+  const double col{(x - m_min_x) / m_cell_size};
+  if (!(col >= 0.0)) return 0; // Also catches NaN
+  if (col >= m_n_cols) return m_n_cols - 1;
+  return static_cast<int>(col);
+}
+
+int food_grid::get_row(const double y) const noexcept
+{
+  const double row{(y - m_min_y) / m_cell_size};
+  if (!(row >= 0.0)) return 0; // Also catches NaN
+  if (row >= m_n_rows) return m_n_rows - 1;
+  return static_cast<int>(row);
+}
+
+void food_grid::query(const double min_x,
+                      const double min_y,
+                      const double max_x,
+                      const double max_y,
+                      std::vector<int>& indices) const
+{
+  const std::size_t n_before{indices.size()};
+  const int col_begin{get_col(min_x)};
+  const int col_end{get_col(max_x) + 1};
+  const int row_begin{get_row(min_y)};
+  const int row_end{get_row(max_y) + 1};
+  // When the rectangle overlaps with most cells, a pass over all items
+  // is faster than sorting the items of the cells
+  const int n_cells{static_cast<int>(m_cells.size())};
+  if ((col_end - col_begin) * (row_end - row_begin) * 2 > n_cells)
+    {
+      const int n_indices{static_cast<int>(m_cell_of_item.size())};
+      for (int i = 0; i != n_indices; ++i)
+        {
+          const int cell{m_cell_of_item[i]};
+          if (cell == -1) continue;
+          const int col{cell % m_n_cols};
+          const int row{cell / m_n_cols};
+          if (col >= col_begin && col < col_end && row >= row_begin && row < row_end)
+            {
+              indices.push_back(i);
+            }
+        }
+      return;
+    }
+  for (int row = row_begin; row < row_end; ++row)
+    {
+      for (int col = col_begin; col < col_end; ++col)
+        {
+          const std::vector<int>& cell = m_cells[(row * m_n_cols) + col];
+          indices.insert(std::end(indices), std::begin(cell), std::end(cell));
+        }
+    }
+  std::sort(std::begin(indices) + static_cast<std::ptrdiff_t>(n_before), std::end(indices));
+}
+
+void test_food_grid() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  const coordinate top_left(0.0, 0.0);
+  const coordinate bottom_right(1000.0, 500.0);
+  // An empty grid has no items
+  {
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, {});
+    std::vector<int> indices;
+    g.query(-1000.0, -1000.0, 5000.0, 5000.0, indices);
+    assert(indices.empty());
+    assert(g.get_n_items() == 0);
+    assert(g.get_n_cols() == 10);
+    assert(g.get_n_rows() == 5);
+  }
+  // Tiny cells do not make a huge grid
+  {
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 0.001, {});
+    assert(g.get_n_cols() <= food_grid::get_max_n_cells_per_axis());
+    assert(g.get_n_rows() <= food_grid::get_max_n_cells_per_axis());
+    assert(g.get_cell_size() > 0.001);
+  }
+  // Only the uneaten food items are put in the grid
+  {
+    const std::vector<food> v{
+      food(coordinate(10.0, 10.0)),
+      food(coordinate(20.0, 10.0), color(), 100, food_state::eaten),
+      food(coordinate(900.0, 400.0), color(), 100, food_state::uneaten, 30.0)
+    };
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, v);
+    assert(g.get_n_items() == 2);
+    assert(g.contains(0));
+    assert(!g.contains(1));
+    assert(g.contains(2));
+    assert(!g.contains(3));
+    assert(g.get_max_radius() == 30.0);
+  }
+  // A query gives all items in the overlapping cells, sorted
+  {
+    const std::vector<food> v{
+      food(coordinate(450.0, 250.0)),
+      food(coordinate(10.0, 10.0)),
+      food(coordinate(420.0, 280.0)),
+      food(coordinate(800.0, 250.0)),
+      food(coordinate(-50.0, 2000.0))
+    };
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, v);
+    std::vector<int> indices;
+    g.query(400.0, 200.0, 499.0, 299.0, indices);
+    assert(indices == std::vector<int>({0, 2}));
+    // Items outside of the rectangle are in the nearest cell
+    indices.clear();
+    g.query(0.0, 450.0, 50.0, 500.0, indices);
+    assert(indices == std::vector<int>({4}));
+    indices.clear();
+    g.query(-1000.0, -1000.0, 5000.0, 5000.0, indices);
+    assert(indices == std::vector<int>({0, 1, 2, 3, 4}));
+  }
+  // An erased item is not found, also not after erasing it twice
+  {
+    const std::vector<food> v{
+      food(coordinate(450.0, 250.0)),
+      food(coordinate(460.0, 250.0)),
+      food(coordinate(470.0, 250.0))
+    };
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, v);
+    assert(g.count_items_at(499.0, 299.0) == 3);
+    g.erase(0);
+    g.erase(0);
+    assert(!g.contains(0));
+    assert(g.get_n_items() == 2);
+    assert(g.count_items_at(499.0, 299.0) == 2);
+    assert(g.count_items_at(10.0, 10.0) == 0);
+    std::vector<int> indices;
+    g.query(400.0, 200.0, 499.0, 299.0, indices);
+    assert(indices == std::vector<int>({1, 2}));
+  }
+  // Inserting an item again moves it
+  {
+    const std::vector<food> v{food(coordinate(450.0, 250.0))};
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, v);
+    g.insert(0, food(coordinate(50.0, 50.0)));
+    assert(g.get_n_items() == 1);
+    std::vector<int> indices;
+    g.query(400.0, 200.0, 499.0, 299.0, indices);
+    assert(indices.empty());
+    g.query(0.0, 0.0, 99.0, 99.0, indices);
+    assert(indices == std::vector<int>({0}));
+  }
+  // After many random inserts and erases, a query gives
+  // the same items as a loop over all items,
+  // for small rectangles and for those that overlap with most cells
+  {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> x(-100.0, 1100.0);
+    std::uniform_real_distribution<double> y(-100.0, 600.0);
+    std::uniform_int_distribution<int> index(0, 199);
+    std::vector<food> v(200);
+    for (auto& f : v) f = food(coordinate(x(rng), y(rng)));
+    food_grid g;
+    g.rebuild(top_left, bottom_right, 37.0, v);
+    for (int i = 0; i != 1000; ++i)
+      {
+        const int j{index(rng)};
+        if (v[j].is_eaten())
+          {
+            v[j] = food(coordinate(x(rng), y(rng)));
+            g.insert(j, v[j]);
+          }
+        else
+          {
+            v[j].set_food_state(food_state::eaten);
+            g.erase(j);
+          }
+      }
+    for (int i = 0; i != 100; ++i)
+      {
+        const double r{i % 2 ? 50.0 : 400.0};
+        const double cx{x(rng)};
+        const double cy{y(rng)};
+        std::vector<int> indices;
+        g.query(cx - r, cy - r, cx + r, cy + r, indices);
+        assert(std::is_sorted(std::begin(indices), std::end(indices)));
+        for (int j = 0; j != 200; ++j)
+          {
+            const bool is_found{std::binary_search(std::begin(indices), std::end(indices), j)};
+            assert(!is_found || !v[j].is_eaten());
+            if (!v[j].is_eaten() && std::abs(v[j].get_x() - cx) < r && std::abs(v[j].get_y() - cy) < r)
+              {
+                assert(is_found);
+              }
+          }
+      }
+  }
+#endif // no tests in release
+}
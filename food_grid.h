@@ -0,0 +1,94 @@
+#ifndef FOOD_GRID_H
+#define FOOD_GRID_H
+
+#include "coordinate.h"
+#include "food.h"
+#include <vector>
+
+/// A uniform grid over a rectangle with the uneaten food items,
+/// to quickly find the food items near a player. Unlike the
+/// spatial_grid, it is updated per item: a food item is taken
+/// out when eaten and put back when it regenerates, in constant time.
+/// Food items outside of the rectangle are put in the nearest cell at the border
+class food_grid
+{
+public:
+  food_grid();
+
+  /// Put the uneaten food items in the grid, removing the earlier ones.
+  /// Item i is food[i].
+  /// @param top_left the top-left corner of the rectangle covered by the grid
+  /// @param bottom_right the bottom-right corner of the rectangle covered by the grid
+  /// @param cell_size the minimal width and height of a cell
+  void rebuild(const coordinate& top_left,
+               const coordinate& bottom_right,
+               const double cell_size,
+               const std::vector<food>& food);
+
+  /// Put food item i in the grid, at the cell of its position.
+  /// If it is in the grid already, it is moved there
+  void insert(const int i, const food& f);
+
+  /// Take food item i out of the grid, if it is in the grid
+  void erase(const int i);
+
+  /// Is food item i in the grid?
+  bool contains(const int i) const noexcept;
+
+  /// Get all items in the cells that overlap with a rectangle,
+  /// in increasing order of index. These are appended to 'indices'
+  void query(const double min_x,
+             const double min_y,
+             const double max_x,
+             const double max_y,
+             std::vector<int>& indices) const;
+
+  /// The width and height of a cell, which can be bigger than
+  /// requested, as the number of cells per axis is limited
+  double get_cell_size() const noexcept { return m_cell_size; }
+
+  int get_n_cols() const noexcept { return m_n_cols; }
+  int get_n_rows() const noexcept { return m_n_rows; }
+
+  /// The number of items in the grid
+  int get_n_items() const noexcept { return m_n_items; }
+
+  /// The number of items in the cell a position is in
+  int count_items_at(const double x, const double y) const noexcept;
+
+  /// The biggest radius of the items put in the grid since the last rebuild
+  double get_max_radius() const noexcept { return m_max_radius; }
+
+  /// The maximum number of cells along each axis,
+  /// so that tiny cells do not make a huge grid
+  static int get_max_n_cells_per_axis() noexcept { return 256; }
+
+private:
+  double m_min_x;
+  double m_min_y;
+  double m_cell_size;
+  int m_n_cols;
+  int m_n_rows;
+  int m_n_items;
+  double m_max_radius;
+
+  /// The item indices in each cell, in no particular order
+  std::vector<std::vector<int>> m_cells;
+
+  /// The cell index of each item, -1 if the item is not in the grid
+  std::vector<int> m_cell_of_item;
+
+  /// The index of each item within its cell
+  std::vector<int> m_slot_of_item;
+
+  /// Get the column a x coordinate is in, clamped to the grid
+  int get_col(const double x) const noexcept;
+
+  /// Get the row a y coordinate is in, clamped to the grid
+  int get_row(const double y) const noexcept;
+};
+
+/// Test the food grid
+void test_food_grid();
+
+#endif // FOOD_GRID_H
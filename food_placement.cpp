@@ -0,0 +1,37 @@
+#include "food_placement.h"
+#include <cassert>
+#include <sstream>
+
+std::string to_str(food_placement p)
+{
+  switch (p)
+  {
+  case food_placement::uniform:
+    return "uniform";
+  default:
+    assert(p == food_placement::density_aware);
+    return "density_aware";
+  }
+}
+
+std::ostream &operator<<(std::ostream &os, const food_placement p)
+{
+  os << to_str(p);
+  return os;
+}
+
+void test_food_placement()
+{
+#ifndef NDEBUG // no tests in release
+  // Food placements have a different name
+  {
+    assert(to_str(food_placement::uniform) != to_str(food_placement::density_aware));
+  }
+  // Food placements can be written to a stream
+  {
+    std::stringstream s;
+    s << food_placement::density_aware;
+    assert(s.str() == "density_aware");
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,24 @@
+#ifndef FOOD_PLACEMENT_H
+#define FOOD_PLACEMENT_H
+
+#include <iosfwd>
+#include <string>
+
+/// How the game picks the position of a regenerating food item.
+/// Either way, it avoids the players and the shelters
+enum class food_placement
+{
+  /// Anywhere in the environment, each position is equally likely
+  uniform,
+
+  /// Where there is the least uneaten food,
+  /// which spreads the food over the environment
+  density_aware
+};
+
+std::string to_str(food_placement p);
+std::ostream &operator<<(std::ostream &os, const food_placement p);
+
+void test_food_placement();
+
+#endif // FOOD_PLACEMENT_H
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <iostream>
 #include <random>
+#include <stdexcept>
+#include <string>
 
 game::game(const environment& the_environment,
            int num_players,
@@ -20,6 +22,8 @@ game::game(const environment& the_environment,
            int seed):
   m_seed{seed},
   m_rng(seed),
+  m_shelter_rng(static_cast<std::uint64_t>(seed), 1),
+  m_food_rng(static_cast<std::uint64_t>(seed), 2),
   m_n_ticks{n_ticks},
   m_player(static_cast<unsigned int>(num_players), player()),
   m_enemies(n_enemies, enemy()),
@@ -27,11 +31,11 @@ game::game(const environment& the_environment,
   m_food(n_food, food()),
   m_shelters(n_shelters, shelter())
 {
-
   for (unsigned int i = 0; i != m_player.size(); ++i)
     {
 
-      auto ID = std::to_string(i);
+      const int ID = static_cast<int>(i);
+      m_player_names.push_back(std::to_string(i));
       coordinate player_position(
             300.0 + static_cast<unsigned int>(m_dist_x_pls) * i,
             400.0);
@@ -71,11 +75,13 @@ game::game(const environment& the_environment,
         ++i;
       }
   }
+
+  rebuild_food_grid();
 }
 
-void add_projectile(game &g, const projectile &p)
+bool add_projectile(game &g, const projectile &p)
 {
-  g.get_projectiles().push_back(p);
+  return g.add_projectile(p);
 }
 
 
@@ -122,6 +128,11 @@ double calc_var(const std::vector<double>& v, double mean_v){
   return v_var;
 }
 
+double calc_var(const std::vector<double>& v)
+{
+  return calc_var(v, calc_mean(v));
+}
+
 
 double get_nth_player_size(const game& g, const int i)
 {
@@ -189,61 +200,50 @@ void game::do_action(const int player_index, action_type action)
   do_action(m_player[player_index], action);
 }
 
+/// A member function of player that does an action
+typedef void (player::*player_action)();
+
+/// The member function of player for each action,
+/// in the order of the action_type values
+static const player_action player_actions[] = {
+  &player::turn_left,        // action_type::turn_left
+  &player::turn_right,       // action_type::turn_right
+  &player::accelerate,       // action_type::accelerate
+  &player::brake,            // action_type::brake
+  &player::acc_backward,     // action_type::acc_backward
+  &player::shoot,            // action_type::shoot
+  nullptr,                   // action_type::none
+  &player::shoot_stun_rocket // action_type::shoot_stun_rocket
+};
+static_assert(static_cast<int>(action_type::shoot_stun_rocket) + 1
+              == sizeof(player_actions) / sizeof(player_actions[0]),
+              "Every action_type must have a player_action");
+
+/// Let a player do an action, assumes the player is not stunned
+static void do_player_action(player& p, const action_type action) noexcept
+{
+  const player_action f{player_actions[static_cast<int>(action)]};
+  if (f) (p.*f)();
+}
+
 void game::do_action(player& player, action_type action)
 {
   if(!(player.get_state() == player_state::stunned))
   {
-    switch (action)
-    {
-      case action_type::turn_left:
-      {
-        player.turn_left();
-        break;
-      }
-      case action_type::turn_right:
-      {
-        player.turn_right();
-        break;
-      }
-      case action_type::accelerate:
-      {
-        player.accelerate();
-        break;
-      }
-      case action_type::brake:
-      {
-        player.brake();
-        break;
-      }
-      case action_type::acc_backward:
-      {
-        player.acc_backward();
-        break;
-      }
-      case action_type::shoot:
-      {
-        player.shoot();
-        break;
-      }
-      case action_type::shoot_stun_rocket:
-      {
-        player.shoot_stun_rocket();
-        break;
-      }
-      case action_type::none:
-        return;
-    }
+    do_player_action(player, action);
+    m_is_player_grid_up_to_date = false;
   }
 }
 
 void game::do_actions() noexcept
 {
-
+  m_is_player_grid_up_to_date = false;
   for(auto& player: m_player)
     {
-      for(const auto& action : player.get_action_set())
+      if (player.get_state() == player_state::stunned) continue;
+      for(const auto action : player.get_action_set())
         {
-          do_action(player, action);
+          do_player_action(player, action);
         }
     }
 }
@@ -268,144 +268,217 @@ void game::set_collision_vector( int lhs,  int rhs)
 
 void game::apply_inertia()
 {
-
-  for (auto& player: m_player)
-    {
-      if (player.get_speed() != 0.0)
-        {
-          //Player moves based on its speed and position
-          player.move();
-          //Then its speed gets decreased by attrition
-          player.brake();
-
-        }
-    }
+  // Players move based on their speed and position,
+  // then their speed gets decreased by attrition
+  ::apply_inertia(m_player);
+  m_is_player_grid_up_to_date = false;
 }
 
 void game::move_shelter()
 {
   for (auto & shelter: m_shelters)
-    shelter.make_shelter_drift();
+    shelter.make_shelter_drift(m_shelter_rng);
 }
 
 void game::move_projectiles()
 {
-  for (auto &p : m_projectiles)
-    {
-//      p.set_type(projectile_type::rocket);
-      p.move();
-    }
+  m_projectiles.move();
+}
+
+void game::cull_projectiles()
+{
+  const auto is_gone = [this](const projectile& p)
+  {
+    return p.get_age() >= m_max_projectile_age || is_out_of_bounds(p, m_environment);
+  };
+  m_projectiles.cull(is_gone);
 }
 
 void game::projectile_collision()
 {
+  m_projectile_hits.clear();
 
-  // For every projectile ...
-  for (int i = 0 ; i != count_n_projectiles(*this) ; ++i)
-  {
-    //For every player...
-    const int n_players = static_cast<int>(get_v_player().size());
-    for(int j = 0; j != n_players; ++j)
+  double max_player_radius{0.0};
+  for (const auto& p : m_player)
     {
-      // if it is not the one that shot it ...
-      if(!(this->get_projectiles()[i].get_owner_id() == m_player[j].get_ID()))
-     {
-      double player_radius = m_player[j].get_diameter() / 2.0;
-      // If the projectile touches the player ...
-      if( this->m_projectiles[i].get_x() > this-> m_player[j].get_x() - player_radius &&
-          this-> m_projectiles[i].get_x() < this-> m_player[j].get_x() + player_radius)
+      max_player_radius = std::max(max_player_radius, p.get_diameter() / 2.0);
+    }
+
+  // For every projectile, find the first player it hits
+  const spatial_grid& grid = get_player_grid();
+  const int n_projectiles{count_n_projectiles(*this)};
+  for (int i = 0; i != n_projectiles; ++i)
+    {
+      const projectile& pr = m_projectiles.get()[i];
+      // Only stun rockets do something when they hit a player
+      if (pr.get_type() != projectile_type::stun_rocket) continue;
+
+      // Only the players near the projectile can be hit
+      m_projectile_hit_candidates.clear();
+      grid.query(get_x(pr) - max_player_radius,
+                 get_y(pr) - max_player_radius,
+                 get_x(pr) + max_player_radius,
+                 get_y(pr) + max_player_radius,
+                 m_projectile_hit_candidates);
+      for (const int j : m_projectile_hit_candidates)
         {
-          if(this-> m_projectiles[i].get_y() > this-> m_player[j].get_y() - player_radius &&
-             this-> m_projectiles[i].get_y() < this-> m_player[j].get_y() + player_radius)
+          player& pl = m_player[j];
+          // The player that shot it cannot be hit, nor a dead player
+          if (pr.get_owner_id() == pl.get_ID() || !is_alive(pl)) continue;
+
+          // If the projectile touches the player ...
+          const double player_radius{pl.get_diameter() / 2.0};
+          if (get_x(pr) > get_x(pl) - player_radius
+              && get_x(pr) < get_x(pl) + player_radius
+              && get_y(pr) > get_y(pl) - player_radius
+              && get_y(pr) < get_y(pl) + player_radius)
             {
-
-              // if the projectile is a stun rocket: stun the player
-              if(this-> m_projectiles[i].get_type() == projectile_type::stun_rocket)  {
-                  this-> m_player[j].set_state(player_state::stunned);
-
-                  // projectile disappears
-                  std::swap(m_projectiles[i], m_projectiles[m_projectiles.size()-1]);
-                  this-> m_projectiles.pop_back();
-
-                  // i can be invalid now, that is i can equal the number of projectiles
-                  // one option is:
-                  //
-                  //  --i;
-                  //
-                  // but this would be dangerous if the last project has disappeared
-                  //
-                  // a simple solution is:
-                  return;
-
+              // ... the player is stunned
+              pl.set_state(player_state::stunned);
+              m_projectile_hits.push_back(projectile_hit(pr, i, j));
+              break;
             }
-          }
         }
+    }
+  if (m_projectile_hits.empty()) return;
+
+  // The projectiles that hit a player disappear,
+  // the other projectiles keep their order
+  std::size_t hit_index{0};
+  const auto has_hit = [this, &hit_index](const int i)
+  {
+    if (hit_index == m_projectile_hits.size()
+        || m_projectile_hits[hit_index].get_projectile_index() != i)
+      {
+        return false;
       }
+    ++hit_index;
+    return true;
+  };
+  m_projectiles.remove_if(has_hit);
+}
+
+void game::resolve_player_collisions()
+{
+  // Find all collisions before anyone grows or shrinks
+  m_colliding_pairs.clear();
+  for (const auto& pair : get_player_pairs())
+    {
+      const player& lhs = m_player[pair.first];
+      const player& rhs = m_player[pair.second];
+      if (is_alive(lhs) && is_alive(rhs) && are_colliding(lhs, rhs))
+        {
+          m_colliding_pairs.push_back(pair);
+        }
+    }
+
+  for (const auto& pair : m_colliding_pairs)
+    {
+      const int winner_index = ::get_winning_player_index(*this, pair.first, pair.second);
+      const int loser_index = ::get_losing_player_index(*this, pair.first, pair.second);
+      m_player[winner_index].grow();
+      m_player[loser_index].shrink();
+      m_is_player_grid_up_to_date = false;
     }
-  }
 }
 
 void game::tick()
 {
-  if(has_collision(*this))
+  // Players that collide grow or shrink
   {
-    //kill_losing_player(*this);
-    grow_winning_player(*this);
-    shrink_losing_player(*this);
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::player_collisions, m_n_ticks);
+    resolve_player_collisions();
   }
 
   // Moves the projectiles
-  move_projectiles();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::move_projectiles, m_n_ticks);
+    move_projectiles();
+  }
 
   //Projectiles hit the players
-  projectile_collision();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::projectile_collision, m_n_ticks);
+    projectile_collision();
+  }
+
+  //Projectiles that left the environment or are too old disappear
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::cull_projectiles, m_n_ticks);
+    cull_projectiles();
+  }
 
   // For now only applies inertia
-  apply_inertia();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::inertia, m_n_ticks);
+    apply_inertia();
+  }
 
   //Move shelters
-  move_shelter();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::move_shelter, m_n_ticks);
+    move_shelter();
+  }
 
   //Actions issued by the players are executed
-  do_actions();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::do_actions, m_n_ticks);
+    do_actions();
+  }
 
   //Check and resolve wall collisions
-  do_wall_collisions();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::wall_collisions, m_n_ticks);
+    do_wall_collisions();
+  }
 
   // Increment timers of all food elements
-  increment_food_timers();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::food_timers, m_n_ticks);
+    increment_food_timers();
+  }
 
   // Make players eat food
-  make_players_eat_food();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::eat_food, m_n_ticks);
+    make_players_eat_food();
+  }
 
   // Regenerate food items
-  regenerate_food_items();
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::regenerate_food, m_n_ticks);
+    regenerate_food_items();
+  }
 
   // players that shoot must generate projectiles
-  for (player &p : m_player)
-    {
-      // When a player shoots, 'm_is_shooting' is true for one tick.
-      // 'game' reads 'm_is_shooting' and if it is true,
-      // it (1) creates a projectile, (2) sets 'm_is_shooting' to false
-      if (p.is_shooting())
-        {
-          put_projectile_in_front_of_player(m_projectiles, p);
-        }
-      p.stop_shooting();
-      assert(!p.is_shooting());
-
-      if (p.is_shooting_stun_rocket())
-        {
-          // Put the projectile just in front outside of the player
-          const double d{p.get_direction()};
-          const double x{get_x(p) + (std::cos(d) * p.get_diameter() * 0.5)};
-          const double y{get_y(p) + (std::sin(d) * p.get_diameter() * 0.5)};
-          const coordinate c{x ,y};
-          m_projectiles.push_back(projectile(c, d, projectile_type::stun_rocket, 100, p.get_ID()));
-        }
-      p.stop_shooting_stun_rocket();
-      assert(!p.is_shooting_stun_rocket());
-    }
+  {
+    PROFILE_TICK_PHASE(m_profiler, tick_phase::shooting, m_n_ticks);
+    for (player &p : m_player)
+      {
+        // When a player shoots, 'm_is_shooting' is true for one tick.
+        // 'game' reads 'm_is_shooting' and if it is true,
+        // it (1) creates a projectile, (2) sets 'm_is_shooting' to false
+        // When there are too many projectiles, nothing is fired
+        if (p.is_shooting())
+          {
+            put_projectile_in_front_of_player(m_projectiles, p);
+          }
+        p.stop_shooting();
+        assert(!p.is_shooting());
+
+        if (p.is_shooting_stun_rocket())
+          {
+            // Put the projectile just in front outside of the player
+            const double d{p.get_direction()};
+            const double x{get_x(p) + (std::cos(d) * p.get_diameter() * 0.5)};
+            const double y{get_y(p) + (std::sin(d) * p.get_diameter() * 0.5)};
+            const coordinate c{x ,y};
+            m_projectiles.add(projectile(c, d, projectile_type::stun_rocket, 100, p.get_ID()));
+          }
+        p.stop_shooting_stun_rocket();
+        assert(!p.is_shooting_stun_rocket());
+      }
+  }
 
   // and updates m_n_ticks
   increment_n_ticks();
@@ -416,28 +489,49 @@ void game::increment_n_ticks()
   ++m_n_ticks;
 }
 
-bool has_collision(const game &g) noexcept
+const std::vector<std::pair<int, int>>& game::get_player_pairs() const
+{
+  get_player_grid();
+  return m_player_pairs;
+}
+
+const spatial_grid& game::get_player_grid() const
 {
-  const auto n_players = static_cast<int>(g.get_v_player().size()) ;
-  for (int i = 0; i < n_players; ++i)
+  if (m_is_player_grid_up_to_date) return m_player_grid;
+
+  m_player_grid_xs.resize(m_player.size());
+  m_player_grid_ys.resize(m_player.size());
+  double max_diameter{1.0};
+  const int n_players{static_cast<int>(m_player.size())};
+  for (int i = 0; i != n_players; ++i)
     {
-      auto& lhs_pl = g.get_player(i);
+      m_player_grid_xs[i] = get_x(m_player[i]);
+      m_player_grid_ys[i] = get_y(m_player[i]);
+      max_diameter = std::max(max_diameter, m_player[i].get_diameter());
+    }
+  // Two players can only collide if they are less than the
+  // biggest diameter apart
+  const double cell_size{max_diameter * 1.25};
+  m_player_grid.rebuild(m_environment.get_top_left(),
+                        m_environment.get_bottom_right(),
+                        cell_size,
+                        m_player_grid_xs,
+                        m_player_grid_ys);
+  m_player_grid.get_candidate_pairs(m_player_pairs);
+  m_is_player_grid_up_to_date = true;
+  return m_player_grid;
+}
 
-      if(is_alive(lhs_pl))
+bool has_collision(const game &g) noexcept
+{
+  for (const auto& pair : g.get_player_pairs())
+    {
+      const player& lhs_pl = g.get_player(pair.first);
+      const player& rhs_pl = g.get_player(pair.second);
+      if (is_alive(lhs_pl) && is_alive(rhs_pl) && are_colliding(lhs_pl, rhs_pl))
         {
-          for (int j = i + 1; j < n_players; ++j)
-            {
-              auto& rhs_pl = g.get_player(j);
-              if(is_alive(rhs_pl))
-                {
-                  if (are_colliding(lhs_pl, rhs_pl))
-                    {
-                      return true;
-                    }
-                }
-            }
+          return true;
         }
-
     }
   return false;
 }
@@ -501,6 +595,24 @@ bool hits_west_wall(const player& p, const environment& e)
   return get_x(p) - p.get_diameter()/2 < get_min_x(e);
 }
 
+const std::string& game::get_player_name(const int id) const
+{
+  if (id < 0 || id >= static_cast<int>(m_player_names.size()))
+    {
+      throw std::invalid_argument("There is no player with ID " + std::to_string(id));
+    }
+  return m_player_names[id];
+}
+
+bool is_out_of_bounds(const projectile& p, const environment& e)
+{
+  const double r{p.get_radius()};
+  return get_x(p) + r < get_min_x(e)
+      || get_x(p) - r > get_max_x(e)
+      || get_y(p) + r < get_min_y(e)
+      || get_y(p) - r > get_max_y(e);
+}
+
 bool hits_wall(const player& p, const environment& e)
 {
 
@@ -517,16 +629,12 @@ bool hits_wall(const player& p, const environment& e)
 std::vector<int> get_collision_members(const game &g) noexcept
 {
   std::vector<int> v_collisions;
-  const auto n_players = static_cast<int>(g.get_v_player().size());
-  for (int i = 0; i < n_players; ++i)
+  for (const auto& pair : g.get_player_pairs())
     {
-      for (int j = i + 1; j < n_players; ++j)
+      if (are_colliding(g.get_player(pair.first), g.get_player(pair.second)))
         {
-          if (are_colliding(g.get_player(i), g.get_player(j)))
-            {
-              v_collisions.push_back(i);
-              v_collisions.push_back(j);
-            }
+          v_collisions.push_back(pair.first);
+          v_collisions.push_back(pair.second);
         }
     }
   return v_collisions;
@@ -534,8 +642,9 @@ std::vector<int> get_collision_members(const game &g) noexcept
 
 void kill_losing_player(game &g)
 {
-  const int first_player_index = get_collision_members(g)[0];
-  const int second_player_index = get_collision_members(g)[1];
+  const std::vector<int> members = get_collision_members(g);
+  const int first_player_index = members[0];
+  const int second_player_index = members[1];
   const player& first_player = g.get_player(first_player_index);
   const player& second_player = g.get_player(second_player_index);
   const int c1 = get_colorhash(first_player);
@@ -556,20 +665,22 @@ void kill_losing_player(game &g)
 
 void grow_winning_player(game &g)
 {
-  const int first_player_index = get_collision_members(g)[0];
-  const int second_player_index = get_collision_members(g)[1];
+  const std::vector<int> members = get_collision_members(g);
+  const int first_player_index = members[0];
+  const int second_player_index = members[1];
 
-  const int winner_index = get_winning_player_index(g, first_player_index, second_player_index);
+  const int winner_index = ::get_winning_player_index(g, first_player_index, second_player_index);
   player& winning_player = g.get_player(winner_index);
   winning_player.grow();
 }
 
 void shrink_losing_player(game &g)
 {
-  const int first_player_index = get_collision_members(g)[0];
-  const int second_player_index = get_collision_members(g)[1];
+  const std::vector<int> members = get_collision_members(g);
+  const int first_player_index = members[0];
+  const int second_player_index = members[1];
 
-  const int loser_index = get_losing_player_index(g, first_player_index, second_player_index);
+  const int loser_index = ::get_losing_player_index(g, first_player_index, second_player_index);
   player& losing_player = g.get_player(loser_index);
   losing_player.shrink();
 }
@@ -596,13 +707,13 @@ bool have_same_position(const L& lhs, const R& rhs)
         get_y(lhs) - get_y(rhs) > -0.0001;
 }
 
-bool is_in_food_radius(const player p, const food f) noexcept
+bool is_in_food_radius(const player& p, const food& f) noexcept
 {
-    const double dx = std::abs(get_x(p) - get_x(f));
-    const double dy = std::abs(get_y(p) - get_y(f));
-    const double actual_distance = std::sqrt((dx * dx) + (dy * dy));
+    // Compare the squared distances, which needs no square root
+    const double dx = get_x(p) - get_x(f);
+    const double dy = get_y(p) - get_y(f);
     const double collision_distance = p.get_diameter() / 2 + f.get_radius();
-    return actual_distance < collision_distance;
+    return (dx * dx) + (dy * dy) < collision_distance * collision_distance;
 }
 
 bool are_colliding(const player &p, const food &f)
@@ -612,11 +723,13 @@ bool are_colliding(const player &p, const food &f)
 
 bool has_any_player_food_collision(const game& g)
 {
+  std::vector<int> indices;
   for (auto& p : g.get_v_player())
     {
-      for(auto& f : g.get_food())
+      g.find_food_near(p, indices);
+      for (const int i : indices)
         {
-          if (are_colliding(p, f))
+          if (are_colliding(p, g.get_food()[i]))
             {
               return true;
             }
@@ -625,19 +738,19 @@ bool has_any_player_food_collision(const game& g)
   return false;
 }
 
-void put_projectile_in_front_of_player(std::vector<projectile>& projectiles, const player& p)
+bool put_projectile_in_front_of_player(projectile_pool& projectiles, const player& p)
 {
   // Put the projectile just in front outside of the player
   const double d{p.get_direction()};
   const double x{get_x(p) + (std::cos(d) * p.get_diameter() * 1.1)};
   const double y{get_y(p) + (std::sin(d) * p.get_diameter() * 1.1)};
   const coordinate c{x, y};
-  projectiles.push_back(projectile(c, d));
+  return projectiles.add(projectile(c, d));
 }
 
 int get_nth_food_timer(const game &g, const int &n)
 {
-  return g.get_food()[n].get_timer();
+  return g.get_food()[n].get_timer(g.get_food_clock());
 }
 
 void game::kill_player(const int index)
@@ -649,9 +762,20 @@ void game::kill_player(const int index)
 
 void game::do_wall_collisions()
 {
-  for(auto& player : m_player)
+  // Put the players back inside in one loop, in the same way as
+  // wall_collision, without copying each player
+  m_is_player_grid_up_to_date = false;
+  const double min_x{get_min_x(m_environment)};
+  const double max_x{get_max_x(m_environment)};
+  const double min_y{get_min_y(m_environment)};
+  const double max_y{get_max_y(m_environment)};
+  for (auto& p : m_player)
     {
-      player = wall_collision(player);
+      const double r{p.get_diameter() / 2};
+      if (p.get_y() + r > max_y) p.set_y(max_y - r);
+      if (p.get_y() - r < min_y) p.set_y(min_y + r);
+      if (p.get_x() + r > max_x) p.set_x(max_x - r);
+      if (p.get_x() - r < min_x) p.set_x(min_x + r);
     }
 }
 
@@ -686,51 +810,275 @@ player game::wall_collision(player p)
 
 void game::increment_food_timers()
 {
-  for (food &f : m_food)
-    {
-      f.increment_timer();
-    }
+  ++m_food_clock;
 }
 
 void game::regenerate_food_items()
 {
-  for (food &f : m_food)
+  m_woken_food.clear();
+  m_food_wheel.advance(m_woken_food);
+  assert(m_food_wheel.get_time() == m_food_clock);
+
+  // The food items may have changed since the wake-up was scheduled,
+  // keep those that are due, once
+  const int n_food{static_cast<int>(m_food.size())};
+  const auto is_not_due = [this, n_food](const int i)
+  {
+    return i >= n_food
+      || !m_food[i].is_eaten()
+      || m_food[i].get_timer(m_food_clock) < m_food[i].get_regeneration_time();
+  };
+  m_woken_food.erase(std::remove_if(std::begin(m_woken_food), std::end(m_woken_food), is_not_due),
+                     std::end(m_woken_food));
+  if (m_woken_food.empty()) return;
+
+  // Regenerate in the order of the food items,
+  // as each one draws from the food RNG
+  std::sort(std::begin(m_woken_food), std::end(m_woken_food));
+  m_woken_food.erase(std::unique(std::begin(m_woken_food), std::end(m_woken_food)),
+                     std::end(m_woken_food));
+  respawn_food_items();
+}
+
+void game::respawn_food_items()
+{
+  // The shelters drift each tick, so put these in a grid again
+  const int n_shelters{static_cast<int>(m_shelters.size())};
+  m_shelter_grid_xs.resize(m_shelters.size());
+  m_shelter_grid_ys.resize(m_shelters.size());
+  double max_shelter_radius{0.0};
+  for (int i = 0; i != n_shelters; ++i)
+    {
+      m_shelter_grid_xs[i] = m_shelters[i].get_x();
+      m_shelter_grid_ys[i] = m_shelters[i].get_y();
+      max_shelter_radius = std::max(max_shelter_radius, m_shelters[i].get_radius());
+    }
+  m_shelter_grid.rebuild(m_environment.get_top_left(),
+                         m_environment.get_bottom_right(),
+                         std::max(1.0, 2.0 * max_shelter_radius),
+                         m_shelter_grid_xs,
+                         m_shelter_grid_ys);
+  double max_player_radius{0.0};
+  for (const auto& p : m_player)
     {
-      if (f.is_eaten() && f.get_timer() >= f.get_regeneration_time())
+      max_player_radius = std::max(max_player_radius, p.get_diameter() / 2.0);
+    }
+
+  // Is a food item with this radius at this position free
+  // of the players and the shelters?
+  const spatial_grid& player_grid = get_player_grid();
+  const auto is_free = [this, &player_grid, max_player_radius, max_shelter_radius](
+    const double x, const double y, const double radius)
+  {
+    const auto is_near = [x, y](const double cx, const double cy, const double distance)
+    {
+      const double dx{cx - x};
+      const double dy{cy - y};
+      return (dx * dx) + (dy * dy) < distance * distance;
+    };
+    m_food_spot_candidates.clear();
+    const double player_reach{max_player_radius + radius};
+    player_grid.query(x - player_reach, y - player_reach, x + player_reach, y + player_reach,
+                      m_food_spot_candidates);
+    for (const int i : m_food_spot_candidates)
+      {
+        const player& p = m_player[i];
+        if (is_near(get_x(p), get_y(p), (p.get_diameter() / 2.0) + radius)) return false;
+      }
+    m_food_spot_candidates.clear();
+    const double shelter_reach{max_shelter_radius + radius};
+    m_shelter_grid.query(x - shelter_reach, y - shelter_reach, x + shelter_reach, y + shelter_reach,
+                         m_food_spot_candidates);
+    for (const int i : m_food_spot_candidates)
+      {
+        const shelter& s = m_shelters[i];
+        if (is_near(s.get_x(), s.get_y(), s.get_radius() + radius)) return false;
+      }
+    return true;
+  };
+
+  const double min_x{get_min_x(*this)};
+  const double min_y{get_min_y(*this)};
+  const double width{get_max_x(*this) - min_x};
+  const double height{get_max_y(*this) - min_y};
+  // A density-aware placement tries a few free positions
+  // and takes the one with the least food in its cell
+  const std::size_t n_tries{m_food_placement == food_placement::density_aware ? 4u : 1u};
+  // A food item that finds no free spot in any round stays eaten
+  // and tries again in the next tick
+  const int n_rounds{8};
+  for (int round = 0; round != n_rounds && !m_woken_food.empty(); ++round)
+    {
+      m_food_draws.resize(m_woken_food.size() * n_tries * 2);
+      m_food_rng.fill_uniform(m_food_draws);
+      std::size_t n_left{0};
+      for (std::size_t k = 0; k != m_woken_food.size(); ++k)
         {
+          const int i{m_woken_food[k]};
+          food& f = m_food[i];
+          bool is_placed{false};
+          coordinate best_position(0.0, 0.0);
+          int best_n_food{0};
+          for (std::size_t t = 0; t != n_tries; ++t)
+            {
+              const std::size_t draw{((k * n_tries) + t) * 2};
+              const double x{min_x + (width * m_food_draws[draw])};
+              const double y{min_y + (height * m_food_draws[draw + 1])};
+              if (!is_free(x, y, f.get_radius())) continue;
+              const int n_food{m_food_grid.count_items_at(x, y)};
+              if (!is_placed || n_food < best_n_food)
+                {
+                  best_position = coordinate(x, y);
+                  best_n_food = n_food;
+                  is_placed = true;
+                }
+            }
+          if (!is_placed)
+            {
+              m_woken_food[n_left++] = i;
+              continue;
+            }
           f.set_food_state(food_state::uneaten);
-          f.place_randomly(get_rng(), {get_min_x(*this), get_min_y(*this)}, {get_max_x(*this), get_max_y(*this)});
+          f.set_position(best_position);
+          m_food_grid.insert(i, f);
         }
-   }
+      m_woken_food.resize(n_left);
+    }
+  for (const int i : m_woken_food)
+    {
+      m_food_wheel.schedule(i, m_food_clock + 1);
+    }
+}
+
+void game::set_food_clock(const int food_clock)
+{
+  m_food_clock = food_clock;
+  m_food_wheel.reset(food_clock);
+  const int n_food{static_cast<int>(m_food.size())};
+  for (int i = 0; i != n_food; ++i)
+    {
+      const food& f = m_food[i];
+      if (f.is_eaten())
+        {
+          m_food_wheel.schedule(i, f.get_eaten_at() + f.get_regeneration_time());
+        }
+    }
+}
+
+void game::rebuild_food_grid()
+{
+  // About the distance at which a player of the default size touches
+  // a food item, so that a query visits a few cells only
+  const double cell_size{75.0};
+  m_food_grid.rebuild(m_environment.get_top_left(),
+                      m_environment.get_bottom_right(),
+                      cell_size,
+                      m_food);
+}
+
+void game::set_food(const std::vector<food>& food_items)
+{
+  m_food = food_items;
+  rebuild_food_grid();
+  set_food_clock(m_food_clock);
+}
+
+void game::set_food_item(const int index, const food& f)
+{
+  assert(index >= 0);
+  assert(index < static_cast<int>(m_food.size()));
+  m_food[index] = f;
+  if (f.is_eaten())
+    {
+      m_food_grid.erase(index);
+      m_food_wheel.schedule(index, f.get_eaten_at() + f.get_regeneration_time());
+    }
+  else
+    {
+      m_food_grid.insert(index, f);
+    }
+}
+
+void game::place_food_randomly(const int index)
+{
+  assert(index >= 0);
+  assert(index < static_cast<int>(m_food.size()));
+  food& f = m_food[index];
+  f.place_randomly(m_food_rng, {get_min_x(*this), get_min_y(*this)}, {get_max_x(*this), get_max_y(*this)});
+  if (!f.is_eaten()) m_food_grid.insert(index, f);
+}
+
+void game::find_food_near(const player& p, std::vector<int>& indices) const
+{
+  indices.clear();
+  const food_grid& grid = m_food_grid;
+  const double reach{(p.get_diameter() / 2.0) + grid.get_max_radius()};
+  grid.query(get_x(p) - reach, get_y(p) - reach, get_x(p) + reach, get_y(p) + reach, indices);
 }
 
 void game::make_players_eat_food()
 {
+  const food_grid& grid = m_food_grid;
   for(auto& player : m_player)
   {
-    const int n_food = static_cast<int>(get_food().size());
-    for(int i = 0; i < n_food; ++i)
+    // Visit the nearby food items in increasing order, as a loop over all
+    // food items would. A player grows when eating and then reaches further,
+    // so then look for nearby food again, beyond the food item just visited
+    int last_index{-1};
+    double queried_reach{-1.0};
+    std::size_t next{0};
+    while (true)
     {
-      if (are_colliding(player, get_food()[i]))
+      const double reach{(player.get_diameter() / 2.0) + grid.get_max_radius()};
+      if (reach > queried_reach)
       {
-        eat_food(get_food()[i]);
+        // Look a bit further, so that a player can grow a few times
+        // before it needs to look again
+        queried_reach = reach * 1.5;
+        m_food_candidates.clear();
+        grid.query(get_x(player) - queried_reach, get_y(player) - queried_reach,
+                   get_x(player) + queried_reach, get_y(player) + queried_reach,
+                   m_food_candidates);
+        next = static_cast<std::size_t>(
+          std::upper_bound(std::begin(m_food_candidates), std::end(m_food_candidates), last_index)
+          - std::begin(m_food_candidates)
+        );
+      }
+      if (next == m_food_candidates.size()) break;
+      const int i{m_food_candidates[next++]};
+      last_index = i;
+      const food& f = m_food[i];
+      if (are_colliding(player, f))
+      {
+        eat_food(i);
         player.grow();
+        m_is_player_grid_up_to_date = false;
         #ifdef FIX_ISSUE_440
         // #440 Food changes the color of the player
-        player.set_color(get_food()[i].get_color());
+        player.set_color(f.get_color());
         #endif // FIX_ISSUE_440
       }
     }
   }
 }
 
-void game::eat_food(food& f)
+void game::eat_food(const int index)
 {
+  assert(index >= 0);
+  assert(index < static_cast<int>(m_food.size()));
+  food& f = m_food[index];
   if(f.is_eaten()) {
       throw std::logic_error("You cannot eat food that already has been eaten!");
     }
   f.set_food_state(food_state::eaten);
-  f.reset_timer();
+  f.set_eaten_at(m_food_clock);
+
+  // Wake the food item up when it regenerates.
+  // Food that is eaten during a tick is scheduled before the wheel
+  // advances to the current food clock, so without a regeneration
+  // time it regenerates in this tick, as when all food was checked
+  m_food_wheel.schedule(index, m_food_clock + f.get_regeneration_time());
+  m_food_grid.erase(index);
 }
 
 void eat_nth_food(game& g, const int n)
@@ -738,7 +1086,7 @@ void eat_nth_food(game& g, const int n)
     if(g.get_food()[n].is_eaten()) {
         throw std::logic_error("You cannot eat food that already has been eaten!");
     }
-    g.eat_food(g.get_food()[n]);
+    g.eat_food(n);
 }
 
 bool nth_food_is_eaten(const game &g, const int &n)
@@ -763,7 +1111,7 @@ coordinate get_nth_food_position(const game& g, const int& food_id)
 }
 void place_nth_food_randomly(game &g, const int &n)
 {
-  g.get_food()[n].place_randomly(g.get_rng(), {get_min_x(g), get_min_y(g)}, {get_max_x(g), get_max_y(g)});
+  g.place_food_randomly(n);
 }
 
 coordinate get_nth_shelter_position(const game &g, const int &n)
@@ -1031,6 +1379,266 @@ void test_game() //!OCLINT tests may be many
 
     assert(has_collision(g));
   }
+  // The uniform grid finds the same collisions as comparing all pairs of players
+  {
+    const int n_players{60};
+    game g(environment(), n_players);
+    std::uniform_real_distribution<double> x(get_min_x(g) - 100.0, get_max_x(g) + 100.0);
+    std::uniform_real_distribution<double> y(get_min_y(g) - 100.0, get_max_y(g) + 100.0);
+    for (auto& p : g.get_v_player())
+      {
+        p.place_to_position(coordinate(x(g.get_rng()), y(g.get_rng())));
+      }
+    // Make the players differ in size
+    for (int i = 0; i != n_players; i += 3) g.get_player(i).grow();
+    std::vector<int> expected;
+    for (int i = 0; i != n_players; ++i)
+      {
+        for (int j = i + 1; j != n_players; ++j)
+          {
+            if (are_colliding(g.get_player(i), g.get_player(j)))
+              {
+                expected.push_back(i);
+                expected.push_back(j);
+              }
+          }
+      }
+    assert(!expected.empty());
+    assert(get_collision_members(g) == expected);
+  }
+  // A player that moved in a tick is found at its new position
+  {
+    game g(environment(), 2);
+    const double d{g.get_player(0).get_diameter()};
+    g.get_player(1).place_to_position(
+      coordinate(get_x(g.get_player(0)) - d - 0.5, get_y(g.get_player(0)))
+    );
+    g.get_player(1).set_direction(0.0);
+    assert(!has_collision(g));
+    g.get_player(1).set_speed(1.0);
+    g.tick();
+    assert(has_collision(g));
+  }
+  // All collisions are resolved in the same tick
+  {
+    game g(environment(), 6);
+    // Red player 0 beats green player 1, red player 3 beats green player 4
+    g.get_player(1).place_to_position(g.get_player(0).get_position());
+    g.get_player(4).place_to_position(g.get_player(3).get_position());
+    assert(get_collision_members(g).size() == 4);
+    const double size_before{get_nth_player_size(g, 0)};
+    g.resolve_player_collisions();
+    assert(get_nth_player_size(g, 0) > size_before);
+    assert(get_nth_player_size(g, 3) > size_before);
+    assert(get_nth_player_size(g, 1) < size_before);
+    assert(get_nth_player_size(g, 4) < size_before);
+  }
+  // Each pair of colliding players is resolved once
+  {
+    game g;
+    // Red beats green, green beats blue, blue beats red:
+    // each player grows once and shrinks once
+    g.get_player(1).place_to_position(g.get_player(0).get_position());
+    g.get_player(2).place_to_position(g.get_player(0).get_position());
+    const double size_before{get_nth_player_size(g, 0)};
+    g.resolve_player_collisions();
+    for (int i = 0; i != 3; ++i)
+      {
+        assert(std::abs(get_nth_player_size(g, i) - size_before) < 0.000001);
+      }
+  }
+  // Dead players do not take part in collisions
+  {
+    game g;
+    g.get_player(1).place_to_position(g.get_player(0).get_position());
+    g.kill_player(1);
+    const double size_before{get_nth_player_size(g, 0)};
+    g.resolve_player_collisions();
+    assert(get_nth_player_size(g, 0) == size_before);
+    assert(get_nth_player_size(g, 1) == size_before);
+  }
+  // After the first shot, firing does not allocate
+  {
+    game g;
+    add_projectile(g, projectile(g.get_player(0).get_position()));
+    assert(g.get_projectiles().capacity() >= g.get_max_n_projectiles());
+  }
+  // A projectile that left the environment disappears
+  {
+    game g;
+    const double r{100.0};
+    const coordinate inside{get_min_x(g) + r, get_max_y(g) - r};
+    const coordinate outside{get_max_x(g) + (3.0 * r), get_max_y(g) - r};
+    add_projectile(g, projectile(inside, 0.0, projectile_type::rocket, r));
+    add_projectile(g, projectile(outside, 0.0, projectile_type::rocket, r));
+    assert(!is_out_of_bounds(g.get_projectiles()[0], g.get_env()));
+    assert(is_out_of_bounds(g.get_projectiles()[1], g.get_env()));
+    g.tick();
+    assert(count_n_projectiles(g) == 1);
+    assert(!is_out_of_bounds(g.get_projectiles()[0], g.get_env()));
+  }
+  // A projectile that is too old disappears
+  {
+    game g;
+    const coordinate c{get_min_x(g) + 200.0, get_max_y(g) - 200.0};
+    projectile old_projectile(c);
+    while (old_projectile.get_age() + 1 != g.get_max_projectile_age())
+      {
+        old_projectile.increment_age();
+      }
+    add_projectile(g, projectile(c));
+    add_projectile(g, old_projectile);
+    g.tick();
+    assert(count_n_projectiles(g) == 1);
+    assert(g.get_projectiles()[0].get_age() == 1);
+  }
+  // When there are too many projectiles, players cannot shoot
+  {
+    game g;
+    const coordinate c{get_min_x(g) + 200.0, get_max_y(g) - 200.0};
+    while (count_n_projectiles(g) != static_cast<int>(g.get_max_n_projectiles()))
+      {
+        add_projectile(g, projectile(c));
+      }
+    const std::size_t capacity{g.get_projectiles().capacity()};
+    assert(!add_projectile(g, projectile(c)));
+    g.do_action(0, action_type::shoot);
+    g.tick();
+    assert(count_n_projectiles(g) == static_cast<int>(g.get_max_n_projectiles()));
+    assert(g.get_projectiles().capacity() == capacity);
+  }
+  // A player that fires a rocket and a stun rocket at once
+  // fires only one of these when there is room for one
+  {
+    game g;
+    const coordinate c{get_min_x(g) + 200.0, get_max_y(g) - 200.0};
+    while (count_n_projectiles(g) != static_cast<int>(g.get_max_n_projectiles()) - 1)
+      {
+        add_projectile(g, projectile(c));
+      }
+    const std::size_t capacity{g.get_projectiles().capacity()};
+    g.do_action(0, action_type::shoot);
+    g.do_action(0, action_type::shoot_stun_rocket);
+    g.tick();
+    assert(count_n_projectiles(g) <= static_cast<int>(g.get_max_n_projectiles()));
+    assert(g.get_projectiles().capacity() == capacity);
+  }
+  // A copy of a game reserves room for all projectiles when it fires
+  {
+    const game g;
+    game copy{g};
+    assert(copy.get_projectiles().capacity() < copy.get_max_n_projectiles());
+    copy.do_action(0, action_type::shoot);
+    copy.tick();
+    assert(count_n_projectiles(copy) == 1);
+    assert(copy.get_projectiles().capacity() >= copy.get_max_n_projectiles());
+  }
+  // All actions in the action set are done, unless a player is stunned
+  {
+    game g;
+    for (int i = 0; i != 2; ++i)
+      {
+        add_action(g.get_player(i), action_type::turn_left);
+        add_action(g.get_player(i), action_type::accelerate);
+        add_action(g.get_player(i), action_type::shoot);
+        add_action(g.get_player(i), action_type::none);
+      }
+    g.get_player(1).set_state(player_state::stunned);
+    const double direction_before{g.get_player(0).get_direction()};
+    g.do_actions();
+    assert(g.get_player(0).get_direction() < direction_before);
+    assert(g.get_player(0).get_speed() > 0.0);
+    assert(g.get_player(0).is_shooting());
+    assert(g.get_player(1).get_direction() == direction_before);
+    assert(g.get_player(1).get_speed() == 0.0);
+    assert(!g.get_player(1).is_shooting());
+  }
+  // All stun rockets hit in the same tick, the other projectiles keep their order
+  {
+    game g;
+    const double y{get_max_y(g) - 200.0};
+    const coordinate c1{g.get_player(1).get_position()};
+    const coordinate c2{g.get_player(2).get_position()};
+    add_projectile(g, projectile(coordinate(1000.0, y)));
+    add_projectile(g, projectile(c1, 0.0, projectile_type::stun_rocket, 100, 0));
+    add_projectile(g, projectile(coordinate(1100.0, y)));
+    add_projectile(g, projectile(c2, 0.0, projectile_type::stun_rocket, 100, 0));
+    add_projectile(g, projectile(coordinate(1200.0, y)));
+    g.tick();
+    assert(is_stunned(g.get_player(1)));
+    assert(is_stunned(g.get_player(2)));
+    assert(count_n_projectiles(g) == 3);
+    assert(get_x(g.get_projectiles()[0]) < get_x(g.get_projectiles()[1]));
+    assert(get_x(g.get_projectiles()[1]) < get_x(g.get_projectiles()[2]));
+    const auto& hits = g.get_projectile_hits();
+    assert(hits.size() == 2);
+    assert(hits[0].get_projectile_index() == 1);
+    assert(hits[0].get_player_index() == 1);
+    assert(hits[1].get_projectile_index() == 3);
+    assert(hits[1].get_player_index() == 2);
+    // The hits are of the last tick only
+    g.tick();
+    assert(g.get_projectile_hits().empty());
+  }
+  // A stun rocket does not hit its owner, nor a dead player
+  {
+    game g;
+    g.kill_player(1);
+    add_projectile(g, projectile(g.get_player(0).get_position(), 0.0, projectile_type::stun_rocket, 100, 0));
+    add_projectile(g, projectile(g.get_player(1).get_position(), 0.0, projectile_type::stun_rocket, 100, 0));
+    g.tick();
+    assert(!is_stunned(g.get_player(0)));
+    assert(!is_stunned(g.get_player(1)));
+    assert(count_n_projectiles(g) == 2);
+    assert(g.get_projectile_hits().empty());
+  }
+  // Games with the same seed are the same, also when drifting
+  const auto have_same_shelters = [](const game& lhs, const game& rhs)
+  {
+    const std::vector<coordinate> a = get_all_shelter_positions(lhs);
+    const std::vector<coordinate> b = get_all_shelter_positions(rhs);
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i != a.size(); ++i)
+      {
+        if (get_x(a[i]) != get_x(b[i]) || get_y(a[i]) != get_y(b[i])) return false;
+      }
+    return true;
+  };
+  {
+    const int seed{123};
+    game a(environment(), 3, 0, 42, 1, 1, seed);
+    game b(environment(), 3, 0, 42, 1, 1, seed);
+    game c(environment(), 3, 0, 42, 1, 1, seed + 1);
+    for (int i = 0; i != 10; ++i)
+      {
+        a.tick();
+        b.tick();
+        c.tick();
+      }
+    assert(have_same_shelters(a, b));
+    assert(!have_same_shelters(a, c));
+    place_nth_food_randomly(a, 0);
+    place_nth_food_randomly(b, 0);
+    assert(a.get_food()[0] == b.get_food()[0]);
+  }
+  // Drawing from one random number generator does not change the others
+  {
+    game a;
+    game b;
+    a.get_food_rng()();
+    a.get_rng()();
+    a.tick();
+    b.tick();
+    assert(have_same_shelters(a, b));
+  }
+  // The pairs of players are updated when a player moves
+  {
+    game g;
+    assert(get_collision_members(g).empty());
+    player& p = g.get_player(2);
+    p.place_to_position(g.get_player(1).get_position());
+    assert(get_collision_members(g) == std::vector<int>({1, 2}));
+  }
 #define FIX_ISSUE_233
 #ifndef FIX_ISSUE_233
   // [PRS] A collision kills a player
@@ -1183,9 +1791,8 @@ void test_game() //!OCLINT tests may be many
   //Can modify food items, for example, delete all food items
   {
     game g;
-    g.get_food();
     assert(!g.get_food().empty());
-    g.get_food().clear();
+    g.set_food({});
     assert(g.get_food().empty());
   }
 
@@ -1244,9 +1851,8 @@ void test_game() //!OCLINT tests may be many
   //Can modify food items, for example, delete all food items
   {
     game g;
-    g.get_food();
     assert(!g.get_food().empty());
-    g.get_food().clear();
+    g.set_food({});
     assert(g.get_food().empty());
   }
 
@@ -1394,9 +2000,24 @@ void test_game() //!OCLINT tests may be many
     game g;
     for(size_t i = 0; i != g.get_v_player().size(); i++)
       {
-        assert(g.get_player(i).get_ID() == std::to_string(i));
+        assert(g.get_player(i).get_ID() == static_cast<int>(i));
       }
   }
+  ///Players have a name to display
+  {
+    game g;
+    assert(g.get_player_name(g.get_player(1).get_ID()) == "1");
+    bool has_thrown{false};
+    try
+    {
+      g.get_player_name(-1);
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
 
   ///Players cannot move past wall coordinates as defined in environment
   {
@@ -1677,6 +2298,202 @@ void test_game() //!OCLINT tests may be many
   }
 #endif
 
+  // Each eaten food item regenerates after its own regeneration time
+  {
+    game g(environment(), 3, 0, 0, 1, 3);
+    g.set_food_item(0, food(coordinate(2000.0, 1000.0), color(), 5));
+    g.set_food_item(1, food(coordinate(2000.0, 1000.0), color(), 300));
+    g.set_food_item(2, food(coordinate(2000.0, 1000.0), color(), 1));
+    eat_nth_food(g, 0);
+    eat_nth_food(g, 1);
+    for (int i = 0; i != 5; ++i)
+      {
+        assert(is_nth_food_eaten(g, 0));
+        g.tick();
+      }
+    assert(!is_nth_food_eaten(g, 0));
+    for (int i = 5; i != 300; ++i)
+      {
+        assert(is_nth_food_eaten(g, 1));
+        g.tick();
+      }
+    assert(!is_nth_food_eaten(g, 1));
+    assert(!is_nth_food_eaten(g, 2));
+  }
+
+  // Food without a regeneration time regenerates in the tick it is
+  // eaten in, or, when eaten between ticks, in the next tick
+  {
+    game g;
+    g.set_food_item(0, food(coordinate(2000.0, 1000.0), color(), 0));
+    put_player_on_food(g.get_player(0), g.get_food()[0]);
+    const double diameter{g.get_player(0).get_diameter()};
+    g.tick();
+    assert(g.get_player(0).get_diameter() > diameter);
+    assert(!is_nth_food_eaten(g, 0));
+    eat_nth_food(g, 0);
+    assert(is_nth_food_eaten(g, 0));
+    g.tick();
+    assert(!is_nth_food_eaten(g, 0));
+  }
+
+  // After setting the food clock, eaten food items regenerate on time
+  {
+    game g;
+    food f = g.get_food()[0];
+    f.set_food_state(food_state::eaten);
+    f.set_eaten_at(10);
+    g.set_food_item(0, f);
+    g.set_food_clock(100);
+    assert(get_nth_food_timer(g, 0) == 90);
+    for (int i = 0; i != 10; ++i)
+      {
+        assert(is_nth_food_eaten(g, 0));
+        g.tick();
+      }
+    assert(!is_nth_food_eaten(g, 0));
+  }
+
+  // Regenerated food does not overlap with players or shelters
+  {
+    game g(environment(), 20, 0, 42, 1, 300, 5);
+    for (auto& p : g.get_v_player())
+      {
+        p.place_to_position(coordinate(g.get_food_rng().uniform(0.0, 2000.0), g.get_food_rng().uniform(0.0, 1000.0)));
+      }
+    for (int i = 0; i != 300; ++i)
+      {
+        g.set_food_item(i, food(coordinate(-1000.0, -1000.0), color(), 1));
+        eat_nth_food(g, i);
+      }
+    g.tick();
+    const game& h = g;
+    for (const auto& f : h.get_food())
+      {
+        assert(!f.is_eaten());
+        for (const auto& p : h.get_v_player())
+          {
+            assert(!is_in_food_radius(p, f));
+          }
+        for (const auto& s : h.get_shelters())
+          {
+            const double dx{s.get_x() - f.get_x()};
+            const double dy{s.get_y() - f.get_y()};
+            assert(std::sqrt((dx * dx) + (dy * dy)) >= s.get_radius() + f.get_radius());
+          }
+      }
+  }
+
+  // Food without a free spot stays eaten until there is one
+  {
+    game g(environment(), 1, 0, 1, 1, 1);
+    const coordinate middle((get_min_x(g) + get_max_x(g)) / 2.0, (get_min_y(g) + get_max_y(g)) / 2.0);
+    g.get_shelters()[0] = shelter(middle, 100000.0, color());
+    g.set_food_item(0, food(coordinate(-1000.0, -1000.0), color(), 1));
+    eat_nth_food(g, 0);
+    g.tick();
+    assert(is_nth_food_eaten(g, 0));
+    g.tick();
+    assert(is_nth_food_eaten(g, 0));
+    g.get_shelters()[0] = shelter(middle, 1.0, color());
+    g.tick();
+    assert(!is_nth_food_eaten(g, 0));
+  }
+
+  // Density-aware placement spreads the regenerated food more evenly
+  {
+    const auto get_max_n_food_per_area = [](const food_placement placement)
+    {
+      game g(environment(), 1, 0, 0, 1, 400, 3);
+      g.set_food_placement(placement);
+      for (int i = 0; i != 400; ++i)
+        {
+          g.set_food_item(i, food(coordinate(-1000.0, -1000.0), color(), 1));
+          eat_nth_food(g, i);
+        }
+      g.tick();
+      // Count the food items in 8 x 4 areas
+      std::vector<int> n_food(32, 0);
+      const game& h = g;
+      for (const auto& f : h.get_food())
+        {
+          const int col{std::min(7, static_cast<int>(8.0 * (f.get_x() - get_min_x(h)) / (get_max_x(h) - get_min_x(h))))};
+          const int row{std::min(3, static_cast<int>(4.0 * (f.get_y() - get_min_y(h)) / (get_max_y(h) - get_min_y(h))))};
+          ++n_food[(row * 8) + col];
+        }
+      return *std::max_element(std::begin(n_food), std::end(n_food));
+    };
+    assert(get_max_n_food_per_area(food_placement::density_aware)
+           < get_max_n_food_per_area(food_placement::uniform));
+  }
+
+  // The food grid follows each change of a food item
+  {
+    game g(environment(), 1, 0, 0, 1, 2);
+    const player& p = g.get_player(0);
+    std::vector<int> indices;
+    g.find_food_near(p, indices);
+    assert(indices.empty());
+    g.set_food_item(1, food(p.get_position()));
+    g.find_food_near(p, indices);
+    assert(indices == std::vector<int>{1});
+    assert(has_any_player_food_collision(g));
+    g.eat_food(1);
+    g.find_food_near(p, indices);
+    assert(indices.empty());
+    g.set_food({food(p.get_position()), food(coordinate(-1000.0, -1000.0))});
+    g.find_food_near(p, indices);
+    assert(indices == std::vector<int>{0});
+  }
+
+  // A player that grows by eating can eat food further away in the same tick
+  {
+    game g(environment(), 1, 0, 0, 1, 2);
+    const coordinate c(1000.0, 500.0);
+    player& p = g.get_player(0);
+    p.place_to_position(c);
+    player grown = p;
+    grown.grow();
+    const double r{g.get_food()[1].get_radius()};
+    const double d{(p.get_diameter() / 2.0 + grown.get_diameter() / 2.0) / 2.0 + r};
+    g.set_food_item(0, food(c));
+    g.set_food_item(1, food(coordinate(get_x(c) + d, get_y(c))));
+    assert(!is_in_food_radius(p, g.get_food()[1]));
+    assert(is_in_food_radius(grown, g.get_food()[1]));
+    g.tick();
+    assert(is_nth_food_eaten(g, 0));
+    assert(is_nth_food_eaten(g, 1));
+  }
+
+  // With food items that are eaten and regenerate, a player eats
+  // the food it is put on and the food collisions are the same as
+  // when checking all food items
+  {
+    game g(environment(), 1, 0, 0, 1, 300, 42);
+    for (int i = 0; i != 300; ++i)
+      {
+        place_nth_food_randomly(g, i);
+        g.set_food_item(i, food(g.get_food()[i].get_position(), color(), 1 + (i % 10)));
+      }
+    const player p0 = g.get_player(0);
+    for (int t = 0; t != 200; ++t)
+      {
+        const game& h = g;
+        const bool was_eaten{h.get_food()[t].is_eaten()};
+        // Keep the player small, as a big player eats all food
+        g.get_player(0) = p0;
+        put_player_on_food(g.get_player(0), h.get_food()[t]);
+        g.tick();
+        assert(was_eaten || h.get_food()[t].is_eaten());
+        bool has_collision{false};
+        for (const auto& f : h.get_food())
+          {
+            if (are_colliding(h.get_player(0), f)) has_collision = true;
+          }
+        assert(has_any_player_food_collision(h) == has_collision);
+      }
+  }
+
 #define FIX_ISSUE_400
 #ifdef FIX_ISSUE_400
   // A game's min and max coordinates can be accessed quickly
@@ -1880,7 +2697,7 @@ void test_game() //!OCLINT tests may be many
            g.get_projectiles().back().get_type() == projectile_type::stun_rocket);
 
     // Put the stun rocket on top of player 2 (at index 1)
-    g.get_projectiles().back().place({get_x(g.get_v_player()[1]), get_y(g.get_v_player()[1])});
+    g.place_projectile(count_n_projectiles(g) - 1, {get_x(g.get_v_player()[1]), get_y(g.get_v_player()[1])});
 
     assert(get_x(g.get_projectiles().back()) == get_x(g.get_v_player()[1]));
     assert(get_y(g.get_projectiles().back()) == get_y(g.get_v_player()[1]));
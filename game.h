@@ -5,17 +5,31 @@
 #include "enemy.h"
 #include "environment.h"
 #include "environment_type.h"
+#include "fast_rng.h"
 #include "food.h"
+#include "food_grid.h"
+#include "food_placement.h"
 #include "player.h"
 #include "player_shape.h"
 #include "projectile.h"
+#include "projectile_hit.h"
+#include "projectile_pool.h"
 #include "shelter.h"
+#include "spatial_grid.h"
+#include "tick_profiler.h"
+#include "timing_wheel.h"
+#include <string>
+#include <utility>
 #include <vector>
 #include "game_options.h"
 #include <random>
 
 /// Contains the game logic.
-/// All data types used by this class are STL and/or Boost
+/// All data types used by this class are STL and/or Boost.
+/// A game is used by one thread at a time, also for reading:
+/// const member functions such as get_player_pairs update the grid
+/// of players when the players moved. The simulation_thread asserts
+/// that it is the only thread that ticks the game while it runs
 class game
 {
 public:
@@ -53,9 +67,27 @@ public:
   /// Get the game's options
   const game_options& get_game_options() const noexcept { return m_options; }
 
+  /// Get the seed of the random number generators
+  int get_seed() const noexcept { return m_seed; }
+
+  /// Get the random number generator engine
+  const std::mt19937& get_rng() const noexcept { return m_rng; }
+
   /// Get the random number generator engine
   std::mt19937& get_rng() noexcept { return m_rng; }
 
+  /// Get the random number generator for the drift of the shelters
+  const fast_rng& get_shelter_rng() const noexcept { return m_shelter_rng; }
+
+  /// Get the random number generator for the drift of the shelters
+  fast_rng& get_shelter_rng() noexcept { return m_shelter_rng; }
+
+  /// Get the random number generator for placing food
+  const fast_rng& get_food_rng() const noexcept { return m_food_rng; }
+
+  /// Get the random number generator for placing food
+  fast_rng& get_food_rng() noexcept { return m_food_rng; }
+
   ///sets the collision vector
   void set_collision_vector(int lhs, int rhs);
 
@@ -65,8 +97,23 @@ public:
   /// Increment the number of ticks
   void increment_n_ticks();
     
-  // Switch a food item's state to eaten
-  void eat_food(food& f);
+  /// Switch the state of the index-th food item to eaten
+  /// and schedule its regeneration
+  void eat_food(const int index);
+
+  /// Get the food clock, which ticks once per tick. The timers of
+  /// the food items count the food clock ticks since these were eaten
+  int get_food_clock() const noexcept { return m_food_clock; }
+
+  /// Set the food clock and schedule the regeneration of all eaten
+  /// food items, e.g. after the food items are replaced
+  void set_food_clock(const int food_clock);
+
+  /// Get how the positions of regenerating food items are picked
+  food_placement get_food_placement() const noexcept { return m_food_placement; }
+
+  /// Set how the positions of regenerating food items are picked
+  void set_food_placement(const food_placement p) noexcept { m_food_placement = p; }
 
   /// Get environment size of the game
   const environment& get_env() const noexcept{ return m_environment; }
@@ -74,17 +121,39 @@ public:
   /// Get enemies
   const std::vector<enemy>& get_enemies() const noexcept { return m_enemies; }
 
+  /// Get enemies
+  std::vector<enemy>& get_enemies() noexcept { return m_enemies; }
+
   /// Get const reference to food vector
   const std::vector<food>& get_food() const noexcept { return m_food; }
 
-  /// Get reference to food vector
-  std::vector<food>& get_food()  noexcept { return m_food; }
+  /// Replace all food items. The eaten ones regenerate
+  /// at the food clock time they were eaten at plus their regeneration time
+  void set_food(const std::vector<food>& food_items);
+
+  /// Replace the index-th food item. If it is eaten, it regenerates
+  /// at the food clock time it was eaten at plus its regeneration time
+  void set_food_item(const int index, const food& f);
+
+  /// Put the index-th food item at a random position
+  void place_food_randomly(const int index);
+
+  /// Get the indices of the uneaten food items that are near enough
+  /// to possibly touch a player, in increasing order.
+  /// These are written to 'indices', which is cleared first
+  void find_food_near(const player& p, std::vector<int>& indices) const;
 
   /// Get the player at a specified index in the vector of players
   const player &get_player(int i) const { return m_player[static_cast<unsigned int>(i)]; }
 
-  /// Get reference to player to change some parameters
-  player &get_player(int i) { return m_player[static_cast<unsigned int>(i)]; }
+  /// Get reference to player to change some parameters.
+  /// The grid of players is rebuilt before it is used next,
+  /// so change the player before calling the game again
+  player &get_player(int i)
+  {
+    m_is_player_grid_up_to_date = false;
+    return m_player[static_cast<unsigned int>(i)];
+  }
 
   /// Gets the player direction
   double get_player_direction(int player_ind);
@@ -92,24 +161,52 @@ public:
   /// Returns const ref to the vector of players
   const std::vector<player> &get_v_player() const { return m_player; }
 
-  /// Returns ref to the vector of players
-  std::vector<player>& get_v_player() { return m_player; }
+  /// Returns ref to the vector of players.
+  /// The grid of players is rebuilt before it is used next,
+  /// so change the players before calling the game again
+  std::vector<player>& get_v_player() { m_is_player_grid_up_to_date = false; return m_player; }
 
   /// Get the projectiles
   const std::vector<projectile> &get_projectiles() const noexcept
   {
-    return m_projectiles;
+    return m_projectiles.get();
   }
 
-  /// Get the projectiles
-  std::vector<projectile> &get_projectiles() noexcept
+  /// Add a projectile, unless the game has the maximum number
+  /// of projectiles already. Returns true if the projectile is added
+  bool add_projectile(const projectile& p) { return m_projectiles.add(p); }
+
+  /// Place the index-th projectile at a coordinate
+  void place_projectile(const int index, const coordinate& c) { m_projectiles.place(index, c); }
+
+  /// Get the projectiles that hit a player in the last tick,
+  /// in the order the projectiles had
+  const std::vector<projectile_hit>& get_projectile_hits() const noexcept
   {
-    return m_projectiles;
+    return m_projectile_hits;
   }
 
-  /// Get enemies
+  /// Get the maximum number of projectiles. Room for these is
+  /// reserved upon the first shot, players cannot shoot when there are this many
+  std::size_t get_max_n_projectiles() const noexcept { return m_projectiles.get_max_size(); }
+
+  /// Get the number of ticks after which a projectile disappears
+  int get_max_projectile_age() const noexcept { return m_max_projectile_age; }
+
+  /// Remove the projectiles that left the environment or are too old.
+  /// The last projectile takes the place of a removed one,
+  /// so the order of the projectiles changes
+  void cull_projectiles();
+
+  /// Get the shelters
   const std::vector<shelter>& get_shelters() const noexcept { return m_shelters; }
 
+  /// Get the shelters
+  std::vector<shelter>& get_shelters() noexcept { return m_shelters; }
+
+  /// Get the name of the player with the given ID, to display
+  const std::string& get_player_name(const int id) const;
+
   /// Kills the index'th player (e.g. index 0 is the first player)
   /// Assumes that index exists, else crashes
   void kill_player(const int index);
@@ -117,15 +214,34 @@ public:
   /// Apply inertia to player movement
   void apply_inertia();
 
+  /// Resolve all collisions between living players in one pass:
+  /// first all colliding pairs are found, then for each pair,
+  /// in order of player index, the winner grows and the loser shrinks
+  void resolve_player_collisions();
+
   /// Move shelter around - for simplicity, in straight line back and forth
   void move_shelter();
 
   /// Applies default actions every tick
   void tick();
 
+  /// Measure the phases of each tick with a profiler,
+  /// nullptr to stop measuring. The profiler must outlive the game
+  void set_profiler(tick_profiler* const profiler) noexcept { m_profiler = profiler; }
+
+  /// Get the profiler that measures the ticks, nullptr if there is none
+  tick_profiler* get_profiler() const noexcept { return m_profiler; }
+
   /// Get initial x distance of players
   int get_dist_x_pls() const noexcept { return m_dist_x_pls; }
 
+  /// Get the pairs of players that are near enough to possibly collide,
+  /// with the lowest index first and sorted, as found by a uniform grid.
+  /// The grid is only rebuilt when the players may have moved or
+  /// grown since the last call, so the queries between two
+  /// stages of a tick that move players share one rebuild
+  const std::vector<std::pair<int, int>>& get_player_pairs() const;
+
   ///Manages collisons with walls
   player wall_collision(player p);
 
@@ -137,6 +253,12 @@ private:
   /// The RNG engine
   std::mt19937 m_rng;
 
+  /// The RNG for the drift of the shelters, derived from the seed
+  fast_rng m_shelter_rng;
+
+  /// The RNG for placing food, derived from the seed
+  fast_rng m_food_rng;
+
   /// the options of the game
   game_options m_options;
 
@@ -159,28 +281,113 @@ private:
   std::vector<food> m_food;
 
   /// the projectiles
-  std::vector<projectile> m_projectiles;
+  projectile_pool m_projectiles;
 
   /// the shelters
   std::vector<shelter> m_shelters;
 
+  /// the names of the players, the ID of a player is its index
+  std::vector<std::string> m_player_names;
+
   /// starting x distance between players
   const int m_dist_x_pls = 300;
 
+  /// the number of ticks after which a projectile disappears
+  const int m_max_projectile_age = 4000;
+
+  /// The uniform grid that finds the players that are near each other
+  mutable spatial_grid m_player_grid;
+
+  /// The pairs of players that may collide, from m_player_grid
+  mutable std::vector<std::pair<int, int>> m_player_pairs;
+
+  /// The player x coordinates m_player_grid was built from
+  mutable std::vector<double> m_player_grid_xs;
+
+  /// The player y coordinates m_player_grid was built from
+  mutable std::vector<double> m_player_grid_ys;
+
+  /// Is m_player_grid still valid for the current players?
+  /// Set to false wherever players may move or change size
+  mutable bool m_is_player_grid_up_to_date = false;
+
+  /// Get the grid with all players, rebuilding it when needed
+  const spatial_grid& get_player_grid() const;
+
+  /// The projectiles that hit a player in the last tick
+  std::vector<projectile_hit> m_projectile_hits;
+
+  /// The players that may be hit by a projectile, from m_player_grid
+  std::vector<int> m_projectile_hit_candidates;
+
+  /// The pairs of living players that collide in this tick
+  std::vector<std::pair<int, int>> m_colliding_pairs;
+
+  /// The profiler that measures the ticks, if any
+  tick_profiler* m_profiler = nullptr;
+
   /// Moves the projectiles
   void move_projectiles();
 
-  /// Processess the collision between projectiles and players
+  /// Processess the collision between projectiles and players.
+  /// A stun rocket stuns the first living player it touches,
+  /// that is not its owner, and then disappears
   void projectile_collision();
 
-  // Increment timers of food items
+  /// The food clock
+  int m_food_clock = 0;
+
+  /// The wake-ups of the eaten food items, at the food clock
+  /// time these regenerate
+  timing_wheel m_food_wheel;
+
+  /// The food items that wake up in this tick
+  std::vector<int> m_woken_food;
+
+  /// The uniform grid with the uneaten food items. All changes
+  /// to the food items go through the game, which updates it per item
+  food_grid m_food_grid;
+
+  /// Put all uneaten food items in m_food_grid
+  void rebuild_food_grid();
+
+  /// The food items a player may touch, from m_food_grid
+  std::vector<int> m_food_candidates;
+
+  /// How the positions of regenerating food items are picked
+  food_placement m_food_placement = food_placement::uniform;
+
+  /// The uniform grid that finds the shelters near a food item
+  spatial_grid m_shelter_grid;
+
+  /// The shelter x coordinates m_shelter_grid was built from
+  std::vector<double> m_shelter_grid_xs;
+
+  /// The shelter y coordinates m_shelter_grid was built from
+  std::vector<double> m_shelter_grid_ys;
+
+  /// The random numbers for the positions of the respawning food items
+  std::vector<double> m_food_draws;
+
+  /// The players or shelters that may be at a position of a respawning food item
+  std::vector<int> m_food_spot_candidates;
+
+  // Increment timers of food items, by ticking the food clock
   void increment_food_timers();
 
   // Make players eat food items they are on top of
   void make_players_eat_food();
 
-  // Regenerate food items where relevant
+  // Regenerate the food items that wake up in this tick
   void regenerate_food_items();
+
+  /// Make the eaten food items in m_woken_food uneaten and put these
+  /// at a random position that does not overlap with a player or a shelter.
+  /// The positions are drawn for all food items at once, in rounds,
+  /// the food items at a taken spot get another try in the next round.
+  /// A food item without a free spot after all rounds stays eaten
+  /// and tries again in the next tick
+  void respawn_food_items();
 };
 
 /// Get all shelter positions
@@ -202,8 +409,9 @@ double calc_mean(const std::vector<double>& v);
 /// Calculate the variance of a vector of numbers
 double calc_var(const std::vector<double>& v);
 
-/// Add a projectile to the game
-void add_projectile(game& g, const projectile& p);
+/// Add a projectile to the game, unless it has the maximum number
+/// of projectiles already. Returns true if the projectile is added
+bool add_projectile(game& g, const projectile& p);
 
 /// Count the number of projectiles in the game
 int count_n_projectiles(const game &g) noexcept;
@@ -227,7 +435,7 @@ bool has_collision(const player& pl, const projectile& p);
 template <typename L, typename R>
 bool have_same_position(const L& lhs, const R& rhs);
 
-bool is_in_food_radius(const player p, const food f) noexcept;
+bool is_in_food_radius(const player& p, const food& f) noexcept;
 
 /// checks if there is at least one collision between a player
 /// and a projectile in the game
@@ -236,6 +444,9 @@ bool has_collision_with_projectile(const game &) noexcept;
 ///Signal if a player hits a wall in an environment
 bool hits_wall(const player& p, const environment& e);
 
+///Signal if a projectile is completely outside of an environment
+bool is_out_of_bounds(const projectile& p, const environment& e);
+
 std::vector<int> get_collision_members(const game &g) noexcept;
 /// Upon a collision, kills the player that loser
 /// Assumes there is a collision
@@ -259,8 +470,9 @@ bool are_colliding(const player &p, const food &f);
 /// Check the game for any collision between food and players
 bool has_any_player_food_collision(const game& g);
 
-///Places a projectile in front of the player
-void put_projectile_in_front_of_player(std::vector<projectile>& projectiles, const player& p);
+///Places a projectile in front of the player, unless there are
+///too many projectiles. Returns true if the projectile is placed
+bool put_projectile_in_front_of_player(projectile_pool& projectiles, const player& p);
 
 int get_nth_food_timer(const game &g, const int &n);
 
@@ -1,19 +1,30 @@
 # Files
 HEADERS += \
     $$PWD/about.h \
+    $$PWD/action_log.h \
+    $$PWD/action_set.h \
     $$PWD/action_type.h \
+    $$PWD/binary_io.h \
     $$PWD/color.h \
     $$PWD/coordinate.h \
+    $$PWD/drawable_grid.h \
     $$PWD/enemy.h \
     $$PWD/enemy_behavior_type.h \
+    $$PWD/ensemble_runner.h \
     $$PWD/environment.h \
     $$PWD/environment_type.h \
+    $$PWD/fast_rng.h \
+    $$PWD/fixed_timestep.h \
     $$PWD/food.h \
+    $$PWD/food_grid.h \
+    $$PWD/food_placement.h \
     $$PWD/food_state.h \
     $$PWD/food_type.h \
     $$PWD/game.h \
     $$PWD/game_options.h \
     $$PWD/game_resources.h \
+    $$PWD/headless_runner.h \
+    $$PWD/hud.h \
     $$PWD/key_action_map.h \
     $$PWD/menu.h \
     $$PWD/menu_button.h \
@@ -24,28 +35,52 @@ HEADERS += \
     $$PWD/player_state.h \
     $$PWD/program_state.h \
     $$PWD/projectile.h \
+    $$PWD/projectile_hit.h \
+    $$PWD/projectile_pool.h \
     $$PWD/projectile_type.h \
     $$PWD/read_only.h \
+    $$PWD/render_snapshot.h \
+    $$PWD/replay_engine.h \
+    $$PWD/rolling_histogram.h \
     $$PWD/shelter.h \
-    $$PWD/sound_type.h
+    $$PWD/simulation_thread.h \
+    $$PWD/snapshot.h \
+    $$PWD/spatial_grid.h \
+    $$PWD/sound_type.h \
+    $$PWD/state_hash.h \
+    $$PWD/texture_atlas.h \
+    $$PWD/tick_phase.h \
+    $$PWD/tick_profiler.h \
+    $$PWD/timing_wheel.h \
+    $$PWD/triple_buffer.h
 
 SOURCES += \
     $$PWD/about.cpp \
+    $$PWD/action_log.cpp \
+    $$PWD/action_set.cpp \
     $$PWD/action_type.cpp \
+    $$PWD/binary_io.cpp \
     $$PWD/color.cpp \
     $$PWD/coordinate.cpp \
+    $$PWD/drawable_grid.cpp \
     $$PWD/enemy.cpp \
     $$PWD/enemy_behavior_type.cpp \
+    $$PWD/ensemble_runner.cpp \
     $$PWD/environment.cpp \
     $$PWD/environment_type.cpp \
+    $$PWD/fast_rng.cpp \
+    $$PWD/fixed_timestep.cpp \
     $$PWD/food.cpp \
+    $$PWD/food_grid.cpp \
+    $$PWD/food_placement.cpp \
     $$PWD/food_state.cpp \
     $$PWD/food_type.cpp \
     $$PWD/game.cpp \
     $$PWD/game_options.cpp \
     $$PWD/game_resources.cpp \
+    $$PWD/headless_runner.cpp \
+    $$PWD/hud.cpp \
     $$PWD/key_action_map.cpp \
-    $$PWD/main.cpp \
     $$PWD/menu.cpp \
     $$PWD/menu_button.cpp \
     $$PWD/optional.cpp \
@@ -55,10 +90,24 @@ SOURCES += \
     $$PWD/player_state.cpp \
     $$PWD/program_state.cpp \
     $$PWD/projectile.cpp \
+    $$PWD/projectile_hit.cpp \
+    $$PWD/projectile_pool.cpp \
     $$PWD/projectile_type.cpp \
     $$PWD/read_only.cpp \
+    $$PWD/render_snapshot.cpp \
+    $$PWD/replay_engine.cpp \
+    $$PWD/rolling_histogram.cpp \
     $$PWD/shelter.cpp \
-    $$PWD/sound_type.cpp
+    $$PWD/simulation_thread.cpp \
+    $$PWD/snapshot.cpp \
+    $$PWD/spatial_grid.cpp \
+    $$PWD/sound_type.cpp \
+    $$PWD/state_hash.cpp \
+    $$PWD/texture_atlas.cpp \
+    $$PWD/tick_phase.cpp \
+    $$PWD/tick_profiler.cpp \
+    $$PWD/timing_wheel.cpp \
+    $$PWD/triple_buffer.cpp
 
 RESOURCES += \
     game_resources.qrc
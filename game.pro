@@ -7,17 +7,24 @@
 # All files are in here, the rest are just settings
 include(game.pri)
 include(game_view.pri)
+SOURCES += main.cpp
 
 # Use the C++ version that all team members can use
 CONFIG += c++11
 QMAKE_CXXFLAGS += -std=c++11
 
+# The ensemble runner uses std::thread
+CONFIG += thread
+
 # High warning levels
 QMAKE_CXXFLAGS += -Wall -Wextra -Wshadow -Wnon-virtual-dtor -pedantic
 
 # A warning is an error
 QMAKE_CXXFLAGS += -Werror
 
+# Uncomment to compile the tick profiler out
+# DEFINES += NO_TICK_PROFILER
+
 # Debug and release settings
 CONFIG += debug_and_release
 CONFIG(release, debug|release) {
@@ -0,0 +1,39 @@
+# This is the project file of the headless runner.
+#
+# Use 'game.pro' to run the game!
+#
+# The headless runner runs the game logic without a window,
+# with scripted player input, and measures the tick throughput.
+# Run './game_headless --help' to see its options
+
+# All files
+include(game.pri)
+SOURCES += headless_main.cpp
+
+CONFIG += c++11
+QMAKE_CXXFLAGS += -std=c++11
+
+# The ensemble runner uses std::thread
+CONFIG += thread
+
+# No window, no SFML rendering
+DEFINES += LOGIC_ONLY
+
+# Always measure a release build
+CONFIG += release
+CONFIG -= debug
+DEFINES += NDEBUG
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+# High warning levels
+QMAKE_CXXFLAGS += -Wall -Wextra -Wshadow -Wnon-virtual-dtor -pedantic
+
+# A warning is an error
+QMAKE_CXXFLAGS += -Werror
+
+# Qt5
+QT += core gui
+
+# SFML, default compiling
+LIBS += -lsfml-graphics -lsfml-window -lsfml-system -lsfml-audio
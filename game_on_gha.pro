@@ -12,10 +12,14 @@ win32{
 
 # All files
 include(game.pri)
+SOURCES += main.cpp
 
 CONFIG += c++11
 QMAKE_CXXFLAGS += -std=c++11
 
+# The ensemble runner uses std::thread
+CONFIG += thread
+
 # To get it working on GitHub Actions,
 # we cannot use any SFML thingies
 DEFINES += LOGIC_ONLY
@@ -2,6 +2,7 @@
 #include "key_action_map.h"
 #include "environment_type.h"
 #include <cassert>
+#include <stdexcept>
 
 // Try to define the class 'game_options' yourself
 game_options::game_options(
@@ -22,13 +23,35 @@ game_options::game_options(
 
 }
 
+void game_options::set_tick_rate(const double tick_rate)
+{
+  if (!(tick_rate > 0.0))
+  {
+    throw std::invalid_argument("The tick rate must be positive");
+  }
+  m_tick_rate = tick_rate;
+}
+
+void game_options::set_max_n_ticks_per_frame(const int n)
+{
+  if (n < 1)
+  {
+    throw std::invalid_argument("There must be at least one tick per frame");
+  }
+  m_max_n_ticks_per_frame = n;
+}
+
 bool operator== (const game_options& lhs, const game_options& rhs) noexcept {
   // Check if left-hand side is equal to the right-hand side
   return lhs.get_kam_1() == rhs.get_kam_1()
       && lhs.get_kam_2() == rhs.get_kam_2()
       && lhs.get_kam_3() == rhs.get_kam_3()
       && lhs.get_rng_seed() == rhs.get_rng_seed()
-      && lhs.is_playing_music() == rhs.is_playing_music();
+      && lhs.is_playing_music() == rhs.is_playing_music()
+      && lhs.get_tick_rate() == rhs.get_tick_rate()
+      && lhs.get_max_n_ticks_per_frame() == rhs.get_max_n_ticks_per_frame()
+      && lhs.is_interpolating() == rhs.is_interpolating()
+      && lhs.is_simulating_in_thread() == rhs.is_simulating_in_thread();
 }
 
 bool operator!= (const game_options& lhs, const game_options& rhs) noexcept {
@@ -177,5 +200,44 @@ void test_game_options()
 }
 #endif
 
+  // The tick rate, the catch-up and the interpolation can be tuned
+  {
+    game_options o;
+    assert(o.get_tick_rate() == 60.0);
+    assert(o.get_max_n_ticks_per_frame() == 5);
+    assert(o.is_interpolating());
+    const game_options before = o;
+    o.set_tick_rate(120.0);
+    o.set_max_n_ticks_per_frame(2);
+    o.set_interpolating(false);
+    assert(o.get_tick_rate() == 120.0);
+    assert(o.get_max_n_ticks_per_frame() == 2);
+    assert(!o.is_interpolating());
+    assert(o != before);
+  }
+  // By default, the game ticks on the thread that draws
+  {
+    game_options o;
+    assert(!o.is_simulating_in_thread());
+    const game_options before = o;
+    o.set_simulating_in_thread(true);
+    assert(o.is_simulating_in_thread());
+    assert(o != before);
+  }
+  // The tick rate must be positive
+  {
+    game_options o;
+    bool has_thrown{false};
+    try
+    {
+      o.set_tick_rate(0.0);
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+
   #endif // NDEBUG
 }
@@ -36,6 +36,32 @@ public:
 
   const environment_type& get_environment_type() const noexcept { return m_environment_type; };
 
+  ///Get the number of game ticks per second
+  double get_tick_rate() const noexcept { return m_tick_rate; }
+
+  ///Set the number of game ticks per second, must be positive
+  void set_tick_rate(const double tick_rate);
+
+  ///Get the maximum number of ticks per frame, to catch up on a slow machine
+  int get_max_n_ticks_per_frame() const noexcept { return m_max_n_ticks_per_frame; }
+
+  ///Set the maximum number of ticks per frame, must be at least one
+  void set_max_n_ticks_per_frame(const int n);
+
+  ///Checks if frames show the players, projectiles and shelters
+  ///between their last two positions
+  bool is_interpolating() const noexcept { return m_interpolate; }
+
+  ///Sets if frames show the players, projectiles and shelters
+  ///between their last two positions
+  void set_interpolating(const bool interpolate) noexcept { m_interpolate = interpolate; }
+
+  ///Checks if the game ticks on a thread of its own, apart from the drawing
+  bool is_simulating_in_thread() const noexcept { return m_simulate_in_thread; }
+
+  ///Sets if the game ticks on a thread of its own, apart from the drawing
+  void set_simulating_in_thread(const bool simulate_in_thread) noexcept { m_simulate_in_thread = simulate_in_thread; }
+
 
 private:
   int m_rng_seed;
@@ -44,6 +70,10 @@ private:
   key_action_map m_kam_2;
   key_action_map m_kam_3;
   environment_type m_environment_type;
+  double m_tick_rate = 60.0;
+  int m_max_n_ticks_per_frame = 5;
+  bool m_interpolate = true;
+  bool m_simulate_in_thread = false;
 };
 
 bool operator== (const game_options& lhs, const game_options& rhs) noexcept;
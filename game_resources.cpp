@@ -3,6 +3,17 @@
 #include <QFile>
 #include <cassert>
 
+/// The images in the atlas, in the order these are put in
+enum class atlas_image
+{
+  rocket,
+  stun_rocket,
+  cat,
+  dragon,
+  franjo,
+  player_sprite
+};
+
 game_resources::game_resources()
 {
   // Load the rocket sprite
@@ -118,6 +129,16 @@ game_resources::game_resources()
       throw std::runtime_error(msg.toStdString());
     }
   }
+  // Put the pictures of the players and projectiles in one texture,
+  // in the order of 'atlas_image'
+  m_atlas.build({
+    m_rocket.copyToImage(),
+    m_stun_rocket.copyToImage(),
+    m_cat.copyToImage(),
+    m_dragon.copyToImage(),
+    m_franjo.copyToImage(),
+    m_player_sprite.copyToImage()
+  });
   /// Load font file
   {
     const QString filename{"arial.ttf"};
@@ -192,12 +213,55 @@ game_resources::game_resources()
 #endif // IS_ON_TRAVIS
 }
 
+const sf::FloatRect& game_resources::get_atlas_rect(const projectile_type t) const
+{
+  switch (t)
+  {
+    case projectile_type::rocket:
+      return m_atlas.get_rect(static_cast<int>(atlas_image::rocket));
+    case projectile_type::cat:
+      return m_atlas.get_rect(static_cast<int>(atlas_image::cat));
+    default:
+      assert(t == projectile_type::stun_rocket);
+      return m_atlas.get_rect(static_cast<int>(atlas_image::stun_rocket));
+  }
+}
+
+const sf::FloatRect& game_resources::get_atlas_rect(const player_shape s) const
+{
+  // Players have always been drawn as Marjon the dragon
+  switch (s)
+  {
+    case player_shape::rocket:
+      return m_atlas.get_rect(static_cast<int>(atlas_image::dragon));
+    case player_shape::circle:
+      return m_atlas.get_rect(static_cast<int>(atlas_image::player_sprite));
+    default:
+      assert(s == player_shape::square);
+      return m_atlas.get_rect(static_cast<int>(atlas_image::franjo));
+  }
+}
+
 void test_game_resources()
 {
   #ifndef NDEBUG // no tests in release
   game_resources g;
   assert(g.get_coastal_world().getSize().x > 0.0);
 
+  // Each projectile type and player shape has its own part of the atlas,
+  // which is as big as its picture
+  {
+    const sf::FloatRect& rocket = g.get_atlas_rect(projectile_type::rocket);
+    const sf::FloatRect& cat = g.get_atlas_rect(projectile_type::cat);
+    const sf::FloatRect& dragon = g.get_atlas_rect(player_shape::rocket);
+    assert(!(rocket == cat));
+    assert(!(rocket == dragon));
+    assert(cat.width == static_cast<float>(g.get_cat().getSize().x));
+    assert(cat.height == static_cast<float>(g.get_cat().getSize().y));
+    assert(dragon.left + dragon.width <= static_cast<float>(g.get_atlas_texture().getSize().x));
+    assert(dragon.top + dragon.height <= static_cast<float>(g.get_atlas_texture().getSize().y));
+  }
+
   #ifdef FIX_ISSUE_136
   assert(g.get_sound(sound_type::shoot).getDuration().asMicroseconds() > 0.0);
   #endif
@@ -1,6 +1,9 @@
 #ifndef GAME_RESOURCES_H
 #define GAME_RESOURCES_H
 
+#include "player_shape.h"
+#include "projectile_type.h"
+#include "texture_atlas.h"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 
@@ -36,6 +39,16 @@ public:
   /// Get a picture of a Cat
   sf::Texture &get_cat() noexcept { return m_cat; }
 
+  /// Get the texture with the pictures of all players and projectiles,
+  /// so that these can be drawn with one draw call
+  const sf::Texture& get_atlas_texture() const noexcept { return m_atlas.get_texture(); }
+
+  /// Get the part of the atlas texture with the picture of a projectile type
+  const sf::FloatRect& get_atlas_rect(const projectile_type t) const;
+
+  /// Get the part of the atlas texture with the picture of a player shape
+  const sf::FloatRect& get_atlas_rect(const player_shape s) const;
+
   /// Get a font
   sf::Font &get_font() noexcept {return m_font; }
 
@@ -96,6 +109,9 @@ private:
 
   /// Rocket
   sf::Texture m_cat;
+
+  /// The pictures of all players and projectiles in one texture
+  texture_atlas m_atlas;
 #ifndef IS_ON_TRAVIS
   // Playing sound on Travis gives thousands of error lines, which causes the
   // build to fail
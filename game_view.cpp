@@ -5,13 +5,16 @@
 #include "food.h"
 #include "game.h"
 #include "game_resources.h"
+#include "replay_engine.h"
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <chrono>
 #include <cmath>
 #include <string>
 #include <sstream>
 
 game_view::game_view(game_options options) :
+    m_game(environment(), 3, 0, 42, 1, 1, options.get_rng_seed()),
     m_window(sf::VideoMode(1280, 720), "tresinformal game"),
     m_v_views(
         m_game.get_v_player().size(),
@@ -20,7 +23,8 @@ game_view::game_view(game_options options) :
             sf::Vector2f(m_window.getSize().x / 2, m_window.getSize().y / 2)
             )
         ),
-    m_options(options)
+    m_options(options),
+    m_action_log(m_game.get_env(), 3, 42, 1, 1, options.get_rng_seed())
 {
 
     //Hardcoded positions of the three sf::views of the three players
@@ -28,6 +32,8 @@ game_view::game_view(game_options options) :
     m_v_views[1].setViewport(sf::FloatRect(0.f, 0.5f, 0.5f, 0.5f));
     m_v_views[2].setViewport(sf::FloatRect(0.5f, 0.5f, 0.5f, 0.5f));
 
+    m_hud_text.setFont(m_game_resources.get_font());
+
 #ifndef IS_ON_TRAVIS
     // Playing sound on Travis gives thousands of error lines, which causes the
     // build to fail
@@ -98,6 +104,12 @@ bool game_view::process_events()
             return true; // Game is done
         }
 
+        else if (m_simulation && (event.type == sf::Event::KeyPressed
+                                  || event.type == sf::Event::KeyReleased))
+        {
+            // The game is on the simulation thread, pass the actions there
+            set_simulation_input(event);
+        }
         else if (event.type == sf::Event::KeyPressed)
         {
             for(auto& player : m_game.get_v_player())
@@ -114,49 +126,164 @@ bool game_view::process_events()
         }
 
     }
-    m_game.tick();
     return false; // if no events proceed with tick
 }
 
+void game_view::set_simulation_input(const sf::Event& event) noexcept
+{
+    const int n_players{static_cast<int>(m_input_actions.size())};
+    for (int i = 0; i != n_players; ++i)
+    {
+        action_set& actions = m_input_actions[static_cast<unsigned int>(i)];
+        const action_type action{m_input_kams[static_cast<unsigned int>(i)].to_action(event.key.code)};
+        if (event.type == sf::Event::KeyPressed) actions.insert(action);
+        else actions.erase(action);
+        m_simulation->set_actions(i, actions);
+    }
+}
+
 void game_view::exec() noexcept
 {
+  if (m_options.is_simulating_in_thread())
+  {
+    exec_threaded();
+    return;
+  }
+  fixed_timestep timestep(m_options.get_tick_rate(), m_options.get_max_n_ticks_per_frame());
+  sf::Clock clock;
   while (m_window.isOpen())
   {
     const bool must_quit{process_events()}; // This is where stun is processed
     if (must_quit) return;
-    m_game.tick();
+    const int n_ticks{timestep.advance(clock.restart().asSeconds())};
+    for (int i = 0; i != n_ticks; ++i)
+    {
+      tick();
+    }
+    m_alpha = m_options.is_interpolating() ? timestep.get_alpha() : 1.0;
     show();
   }
 }
 
+void game_view::exec_threaded() noexcept
+{
+  // The keys and actions of the players, as the game itself
+  // cannot be used while the simulation thread ticks it
+  m_input_kams.clear();
+  m_input_actions.clear();
+  for (const auto& p : m_game.get_v_player())
+  {
+    m_input_kams.push_back(get_player_kam(p));
+    m_input_actions.push_back(p.get_action_set());
+  }
+
+  simulation_thread simulation(
+    m_game,
+    m_action_log,
+    fixed_timestep(m_options.get_tick_rate(), m_options.get_max_n_ticks_per_frame())
+  );
+  m_simulation = &simulation;
+  simulation.start();
+
+  const double tick_duration{1.0 / m_options.get_tick_rate()};
+  while (m_window.isOpen())
+  {
+    if (process_events()) break;
+    // The newest snapshot is drawn between its previous and current state,
+    // by how much time passed since it was taken
+    const render_snapshot& s = simulation.get_newest_snapshot();
+    m_alpha = m_options.is_interpolating()
+      ? get_alpha(s, tick_duration, std::chrono::steady_clock::now()) : 1.0;
+    show(s);
+  }
+  simulation.stop();
+  m_simulation = nullptr;
+}
+
+void game_view::tick()
+{
+    remember_state(m_game, m_previous);
+    record_tick(m_game, m_action_log);
+}
+
+coordinate game_view::get_drawn_player_position(const int i) const
+{
+    const coordinate current{m_game.get_player(i).get_position()};
+    if (m_alpha >= 1.0 || i >= static_cast<int>(m_previous.m_player_positions.size()))
+    {
+        return current;
+    }
+    return interpolate(m_previous.m_player_positions[static_cast<unsigned int>(i)], current, m_alpha);
+}
+
 void game_view::draw_background() noexcept
 {
-    // Draw the background
-    sf::Sprite background_sprite;
-    background_sprite.setPosition(10.0, 10.0);
-    sf::Texture background_texture = m_game_resources.get_coastal_world();
-    background_sprite.setTexture(background_texture);
-    // Scale background so it fits the entire environment
-    double scaling_factor_x = get_max_x(m_game.get_env()) / background_texture.getSize().x;
-    double scaling_factor_y = get_max_y(m_game.get_env()) / background_texture.getSize().y;
-    background_sprite.setScale(scaling_factor_x, scaling_factor_y);
-    m_window.draw(background_sprite);
+    // The background is built in 'show', once for all views
+    m_background.draw(m_window);
 }
 
-void game_view::draw_food() noexcept
+void game_view::index_drawables(const render_snapshot& s)
 {
-    // Create food sprite
-    sf::CircleShape foodsprite(25.0);
-    // Get position of food
-    std::vector<food> foods = m_game.get_food();
-    // Position in landscape
-    food f = foods[0];
-    foodsprite.setPosition(static_cast<float>(get_x(f)),
-            static_cast<float>(get_y(f)));
-    foodsprite.setFillColor(sf::Color(0, 0, 0));
-    if (!f.is_eaten()) {
-        m_window.draw(foodsprite);
-      }
+    m_drawables.clear();
+
+    // The players are drawn around their position
+    for (const auto& player : s.m_players)
+    {
+        const coordinate position{get_drawn_position(player, m_alpha)};
+        m_drawables.add(position.get_x(), position.get_y(), player.m_diameter / 2.0);
+    }
+
+    // The food and shelters are circles with their position at the top-left
+    m_first_food = m_drawables.get_n_items();
+    if (s.m_has_food) {
+        m_drawables.add(s.m_food_position.get_x() + 25.0, s.m_food_position.get_y() + 25.0, 25.0);
+    }
+
+    // The projectiles are rectangles rotated around their position,
+    // so these are drawn within their diagonal from there
+    m_first_projectile = m_drawables.get_n_items();
+    for (const auto &projectile : s.m_projectiles)
+    {
+        const double reach{projectile.m_type == projectile_type::stun_rocket
+            ? std::hypot(381.0, 83.0) : std::hypot(100.0, 100.0)};
+        const coordinate position{get_drawn_position(projectile, m_alpha)};
+        m_drawables.add(position.get_x(), position.get_y(), reach);
+    }
+
+    m_first_shelter = m_drawables.get_n_items();
+    for (const auto &shelter : s.m_shelters)
+    {
+        const double r{shelter.m_radius};
+        const coordinate position{get_drawn_position(shelter, m_alpha)};
+        m_drawables.add(position.get_x() + r, position.get_y() + r, r);
+    }
+
+    const environment& env = m_game.get_env();
+    m_drawables.build(coordinate(get_min_x(env), get_min_y(env)),
+                      coordinate(get_max_x(env), get_max_y(env)));
+}
+
+void game_view::find_visible(const sf::View& view)
+{
+    const sf::Vector2f& center = view.getCenter();
+    const sf::Vector2f& size = view.getSize();
+    m_visible.clear();
+    m_drawables.query(center.x - (size.x / 2.0f), center.y - (size.y / 2.0f),
+                      center.x + (size.x / 2.0f), center.y + (size.y / 2.0f),
+                      m_visible);
+}
+
+void game_view::draw_food(const render_snapshot& s) noexcept
+{
+    for (const int d : m_visible)
+    {
+        if (d < m_first_food) continue;
+        if (d >= m_first_projectile) break;
+        m_sprites.add_circle(nullptr, sf::FloatRect(),
+                             sf::Vector2f(static_cast<float>(s.m_food_position.get_x()),
+                                          static_cast<float>(s.m_food_position.get_y())),
+                             25.0f, sf::Vector2f(0.0f, 0.0f), 0.0f, sf::Color(0, 0, 0));
+    }
 }
 
 void game_view::press_key(const sf::Keyboard::Key& k)
@@ -168,77 +295,59 @@ void game_view::press_key(const sf::Keyboard::Key& k)
 }
 
 
-void game_view::draw_players() noexcept //!OCLINT too long indeed, please
+void game_view::draw_players(const render_snapshot& s) noexcept //!OCLINT too long indeed, please
 //! shorten
 {
-    for (const auto &player : m_game.get_v_player())
+    for (const int i : m_visible)
     {
-        if(is_dead(player))
+        if (i >= m_first_food) break;
+        const player_snapshot& player = s.m_players[static_cast<unsigned int>(i)];
+        if(player.m_is_dead)
           {
             continue;
           }
         // Type conversions that simplify notation
-        const float r{static_cast<float>(player.get_diameter()) / 2.0f};
-        const float x{static_cast<float>(get_x(player))};
-        const float y{static_cast<float>(get_y(player))};
-        const float angle{static_cast<float>(player.get_direction())};
-        const sf::Uint8 red{static_cast<sf::Uint8>(get_redness(player))};
-        const sf::Uint8 green{static_cast<sf::Uint8>(get_greenness(player))};
-        const sf::Uint8 blue{static_cast<sf::Uint8>(get_blueness(player))};
-
-        // Create the player sprite
-        sf::CircleShape circle;
-        circle.setRadius(r);
-        circle.setFillColor(sf::Color(red, green, blue));
-        circle.setTexture(&m_game_resources.get_dragon());
-        circle.setOrigin(r, r);
-        circle.setPosition(x, y);
-        circle.setRotation((angle  * 180.0f / M_PI) - 90);
-
-//        sf::RectangleShape rect;
-//        rect.setSize(sf::Vector2f(r, 2.0f));
-//        rect.setPosition(x, y);
-//        rect.setFillColor(sf::Color(red / 2, green / 2, blue / 2));
-//        rect.setRotation(angle  * 180.0f / M_PI);
-
-        // Draw the player
-        m_window.draw(circle);
-//        m_window.draw(rect);
+        const coordinate position{get_drawn_position(player, m_alpha)};
+        const float r{static_cast<float>(player.m_diameter) / 2.0f};
+        const float x{static_cast<float>(position.get_x())};
+        const float y{static_cast<float>(position.get_y())};
+        const float angle{static_cast<float>(get_drawn_direction(player, m_alpha))};
+        const sf::Uint8 red{static_cast<sf::Uint8>(get_redness(player.m_color))};
+        const sf::Uint8 green{static_cast<sf::Uint8>(get_greenness(player.m_color))};
+        const sf::Uint8 blue{static_cast<sf::Uint8>(get_blueness(player.m_color))};
+
+        // Add the player sprite
+        m_sprites.add_circle(&m_game_resources.get_atlas_texture(),
+                             m_game_resources.get_atlas_rect(player.m_shape),
+                             sf::Vector2f(x, y), r, sf::Vector2f(r, r),
+                             (angle  * 180.0f / M_PI) - 90,
+                             sf::Color(red, green, blue));
     }
 }
 
-void game_view::draw_projectiles() noexcept
+void game_view::draw_projectiles(const render_snapshot& s) noexcept
 {
-    for (const auto &projectile : m_game.get_projectiles())
+    for (const int d : m_visible)
     {
-        if (projectile.get_type() == projectile_type::cat){
-            // Create the projectile sprite
-            sf::RectangleShape rect(sf::Vector2f(100.0, 100.0));
-            rect.setRotation(static_cast<float>(90));
-            rect.setPosition(get_x(projectile), get_y(projectile));
-            rect.setTexture(&m_game_resources.get_cat());
-            rect.rotate(projectile.get_direction() * 180 / M_PI);
-            m_window.draw(rect);
-        }
-
-        if (projectile.get_type() == projectile_type::rocket){
-            // Create the projectile sprite
-            sf::RectangleShape rect(sf::Vector2f(100.0, 100.0));
-            rect.setRotation(static_cast<float>(90));
-            rect.setPosition(get_x(projectile), get_y(projectile));
-            rect.setTexture(&m_game_resources.get_rocket());
-            rect.rotate(projectile.get_direction() * 180 / M_PI);
-            m_window.draw(rect);
+        if (d < m_first_projectile) continue;
+        if (d >= m_first_shelter) break;
+        const projectile_snapshot& projectile = s.m_projectiles[static_cast<unsigned int>(d - m_first_projectile)];
+        const coordinate drawn_position{get_drawn_position(projectile, m_alpha)};
+        const sf::Vector2f position(static_cast<float>(drawn_position.get_x()),
+                                    static_cast<float>(drawn_position.get_y()));
+        const float direction{static_cast<float>(projectile.m_direction * 180 / M_PI)};
+        const sf::Vector2f origin(0.0f, 0.0f);
+        const sf::Texture* texture{&m_game_resources.get_atlas_texture()};
+        const sf::FloatRect& texture_rect = m_game_resources.get_atlas_rect(projectile.m_type);
+
+        // Add the projectile sprite
+        if (projectile.m_type == projectile_type::stun_rocket){
+            m_sprites.add_rectangle(texture, texture_rect, position,
+                                    sf::Vector2f(381.0, 83.0), origin, direction);
         }
-
-        if (projectile.get_type() == projectile_type::stun_rocket){
-            // Create the projectile sprite
-            sf::RectangleShape rect(sf::Vector2f(381.0, 83.0));
-            rect.setRotation(static_cast<float>(0));
-            rect.setPosition(get_x(projectile), get_y(projectile));
-            rect.setTexture(&m_game_resources.get_stun_rocket());
-            rect.rotate(projectile.get_direction() * 180 / M_PI);
-            m_window.draw(rect);
+        else {
+            m_sprites.add_rectangle(texture, texture_rect, position,
+                                    sf::Vector2f(100.0, 100.0), origin, 90 + direction);
         }
 
     }
@@ -246,19 +355,43 @@ void game_view::draw_projectiles() noexcept
 }
 
 
-void game_view::draw_shelters() noexcept
+void game_view::draw_shelters(const render_snapshot& s) noexcept
 {
-    for (const auto &shelter : m_game.get_shelters())
+    for (const int d : m_visible)
     {
-        sf::CircleShape circle(shelter.get_radius());
-        circle.setPosition(get_x(shelter), get_y(shelter));
-        circle.setFillColor(sf::Color(get_redness(shelter), get_greenness(shelter),
-                                      get_blueness(shelter),
-                                      get_opaqueness(shelter)));
-        m_window.draw(circle);
+        if (d < m_first_shelter) continue;
+        const shelter_snapshot& shelter = s.m_shelters[static_cast<unsigned int>(d - m_first_shelter)];
+        const color& c = shelter.m_color;
+        const coordinate position{get_drawn_position(shelter, m_alpha)};
+        m_sprites.add_circle(nullptr, sf::FloatRect(),
+                             sf::Vector2f(static_cast<float>(position.get_x()),
+                                          static_cast<float>(position.get_y())),
+                             static_cast<float>(shelter.m_radius), sf::Vector2f(0.0f, 0.0f), 0.0f,
+                             sf::Color(get_redness(c), get_greenness(c),
+                                       get_blueness(c),
+                                       get_opaqueness(c)));
     }
 }
 
+void game_view::draw_sprites(const render_snapshot& s) noexcept
+{
+    m_sprites.clear();
+
+    // The food is drawn first, so that the players and projectiles,
+    // which share the atlas texture, are drawn with one draw call
+    draw_food(s);
+
+    draw_players(s);
+
+    draw_projectiles(s);
+
+    // The shelters are drawn on top of everything else
+    m_sprites.start_layer();
+    draw_shelters(s);
+
+    m_sprites.draw(m_window);
+}
+
 void game_view::set_player_coords_view() noexcept
 {
     sf::View player_coords_view(
@@ -269,58 +402,52 @@ void game_view::set_player_coords_view() noexcept
     m_window.setView(player_coords_view);
 }
 
-void game_view::draw_player_coords() noexcept
+void game_view::draw_player_coords(const render_snapshot& s) noexcept
 {
-    sf::Text text;
-    text.setFont(m_game_resources.get_font());
-
-    // Concatenate player coordinates string
-    std::vector<player> v_player = m_game.get_v_player();
-    std::string str_player_coords;
-    for(int i = 0; i != static_cast<int>(v_player.size()); i++) {
-        player p = v_player[static_cast<unsigned int>(i)];
-        str_player_coords += "Player " + p.get_ID() + " x = " + std::to_string(trunc(get_x(p)));
-        str_player_coords += "\nPlayer " + p.get_ID() + " y = " + std::to_string(trunc(get_y(p)));
-        str_player_coords += "\n\n";
+    // Only lay out the text again if the coordinates shown changed
+    if (m_hud.update(s)) {
+        m_hud_text.setString(m_hud.get_text());
     }
-    food f = m_game.get_food()[0];
-    str_player_coords += "Food x = " + std::to_string(trunc(get_x(f)));
-    str_player_coords += "y = " + std::to_string(trunc(get_y(f)));
-    str_player_coords += "\n\n";
-
-    text.setString(str_player_coords);
-
-    m_window.draw(text);
+    m_window.draw(m_hud_text);
 }
 
 void game_view::show() noexcept
+{
+    take_snapshot(m_game, m_previous, m_snapshot);
+    show(m_snapshot);
+}
+
+void game_view::show(const render_snapshot& s) noexcept
 {
     // Start drawing the new frame, by clearing the screen
     m_window.clear();
 
+    // Rebuild the background only if the environment or window changed
+    m_background.update(m_game.get_env(), m_game_resources.get_coastal_world(), m_window.getSize());
+
+    // Index the things to draw once for all views
+    index_drawables(s);
+
     for(int i = 0; i != static_cast<int>(m_v_views.size()); i++){
 
+        const coordinate center{get_drawn_position(s.m_players[static_cast<unsigned int>(i)], m_alpha)};
         m_v_views[static_cast<unsigned int>(i)].setCenter(
-                    static_cast<float>(get_x(m_game.get_player(i))),
-                    static_cast<float>(get_y(m_game.get_player(i))));
+                    static_cast<float>(center.get_x()),
+                    static_cast<float>(center.get_y()));
         m_window.setView(m_v_views[static_cast<unsigned int>(i)]);
 
         draw_background();
 
-        draw_players();
-
-        draw_food();
-
-        draw_projectiles();
-
-        draw_shelters();
+        // Each view only draws the things it can see
+        find_visible(m_v_views[static_cast<unsigned int>(i)]);
+        draw_sprites(s);
     }
 
     // Set fourth view for players coordinates
     #ifndef NDEBUG  // coordinates should not be visible in release
     set_player_coords_view();
     // Display player coordinates on the fourth view
-    draw_player_coords();
+    draw_player_coords(s);
     #endif
 
     if (1 == 2)
@@ -339,20 +466,15 @@ void game_view::show() noexcept
 
 key_action_map get_player_kam(const player& p)
 {
-    if(p.get_ID() == "0")
+    switch(p.get_ID())
     {
+    case 0:
         return get_player_1_kam();
-    }
-    else if(p.get_ID() == "1")
-    {
+    case 1:
         return  get_player_2_kam();
-    }
-    else if(p.get_ID() == "2")
-    {
+    case 2:
         return  get_player_3_kam();
-    }
-    else
-    {
+    default:
         //for now return a weird action map
         return
                 key_action_map
@@ -442,13 +564,13 @@ void test_game_view()//!OCLINT tests may be many
     ///given a player get_player_kam provides the correct player kam
     {
         player p;
-        assert(p.get_ID() == "0");
+        assert(p.get_ID() == 0);
         assert(get_player_kam(p).get_raw_map() == get_player_1_kam().get_raw_map());
         assert(get_player_kam(p).get_raw_map() != get_player_2_kam().get_raw_map());
 
-        p =  create_player_with_id("1");
+        p =  create_player_with_id(1);
         assert(get_player_kam(p).get_raw_map() == get_player_2_kam().get_raw_map());
-        p =  create_player_with_id("2");
+        p =  create_player_with_id(2);
         assert(get_player_kam(p).get_raw_map() == get_player_3_kam().get_raw_map());
     }
 #endif
@@ -458,13 +580,13 @@ void test_game_view()//!OCLINT tests may be many
     ///given a player get_player_kam provides the correct player kam
     {
         player p;
-        assert(p.get_ID() == "0");
+        assert(p.get_ID() == 0);
         assert(get_player_kam(p).get_raw_map() == get_player_1_kam().get_raw_map());
         assert(get_player_kam(p).get_raw_map() != get_player_2_kam().get_raw_map());
 
-        p =  create_player_with_id("1");
+        p =  create_player_with_id(1);
         assert(get_player_kam(p).get_raw_map() == get_player_2_kam().get_raw_map());
-        p =  create_player_with_id("2");
+        p =  create_player_with_id(2);
         assert(get_player_kam(p).get_raw_map() == get_player_3_kam().get_raw_map());
 
     }
@@ -476,8 +598,8 @@ void test_game_view()//!OCLINT tests may be many
         player p0;
         player p1;
 
-        p0 = create_player_with_id("0");
-        p1 = create_player_with_id("1");
+        p0 = create_player_with_id(0);
+        p1 = create_player_with_id(1);
 
         sf::Event move_forward_pl_1;
         move_forward_pl_1.key.code = sf::Keyboard::W;
@@ -485,8 +607,8 @@ void test_game_view()//!OCLINT tests may be many
         p0 = player_input(p0,move_forward_pl_1);
         p1 = player_input(p1,move_forward_pl_1);
 
-        assert(p0.get_action_set() == std::set<action_type>{action_type::accelerate} );
-        assert(p1.get_action_set() == std::set<action_type>{action_type::none} );
+        assert(p0.get_action_set() == action_set{action_type::accelerate} );
+        assert(p1.get_action_set() == action_set{action_type::none} );
 
     }
 
@@ -496,10 +618,10 @@ void test_game_view()//!OCLINT tests may be many
         player p0;
         player p1;
 
-        p0 = create_player_with_id("0");
+        p0 = create_player_with_id(0);
         add_action(p0,action_type::accelerate);
 
-        p1 = create_player_with_id("1");
+        p1 = create_player_with_id(1);
         add_action(p1,action_type::accelerate);
 
         sf::Event stop_move_forward_pl_1;
@@ -509,7 +631,7 @@ void test_game_view()//!OCLINT tests may be many
         p1 = player_stop_input(p1,stop_move_forward_pl_1);
 
         assert(p0.get_action_set().empty());
-        assert(p1.get_action_set() == std::set<action_type>{action_type::accelerate} );
+        assert(p1.get_action_set() == action_set{action_type::accelerate} );
 
     }
 
@@ -519,9 +641,125 @@ void test_game_view()//!OCLINT tests may be many
     assert(count_n_projectiles(g) == 0);
     g.press_key(sf::Keyboard::E);
     g.process_events(); // Needed to process the event
+    g.tick(); // Processing events does not tick
     //  #ifdef FIX_ISSUE_239
     assert(count_n_projectiles(g) == 1);
   }
+  // The game uses the seed of the options
+  {
+    const int seed{42};
+    const game_view g(game_options(seed, false));
+    assert(g.get_game().get_seed() == seed);
+  }
+  // Processing events does not tick the game
+  {
+    game_view g;
+    g.process_events();
+    assert(g.get_game().get_n_ticks() == 0);
+    g.tick();
+    assert(g.get_game().get_n_ticks() == 1);
+  }
+  // Players are drawn between their positions before and after the latest tick
+  {
+    game_view g;
+    g.get_game().get_player(0).accelerate();
+    coordinate before{g.get_game().get_player(0).get_position()};
+    g.tick();
+    const coordinate after{g.get_game().get_player(0).get_position()};
+    assert(before != after);
+    g.set_interpolation_alpha(0.0);
+    assert(g.get_drawn_player_position(0) == before);
+    g.set_interpolation_alpha(0.5);
+    assert(g.get_drawn_player_position(0) == interpolate(before, after, 0.5));
+    g.set_interpolation_alpha(1.0);
+    assert(g.get_drawn_player_position(0) == after);
+  }
+  // The background is built upon the first frame and kept afterwards
+  {
+    game_view g;
+    assert(g.get_background().get_n_builds() == 0);
+    g.show();
+    g.show();
+    assert(g.get_background().get_n_builds() == 1);
+  }
+  // A frame draws all players and projectiles with one draw call
+  {
+    game_view g;
+    // Around the player of the last view drawn
+    const coordinate c{g.get_drawn_player_position(2)};
+    for (int i = 0; i != 100; ++i)
+      {
+        add_projectile(g.get_game(),
+          projectile(coordinate(c.get_x() + i, c.get_y() + i), 0.0, projectile_type::rocket));
+      }
+    g.show();
+    // Only the players with rockets have a texture
+    int n_textured_batches{0};
+    for (int i = 0; i != g.get_sprites().get_n_batches(); ++i)
+      {
+        if (g.get_sprites().get_texture(i)) ++n_textured_batches;
+      }
+    assert(n_textured_batches == 1);
+  }
+  // A view only draws the things it can see
+  {
+    game_view g;
+    g.show();
+    const auto count_vertices = [](const sprite_batch& s)
+    {
+      std::size_t n{0};
+      for (int i = 0; i != s.get_n_batches(); ++i) n += s.get_vertices(i).getVertexCount();
+      return n;
+    };
+    const std::size_t n_vertices{count_vertices(g.get_sprites())};
+    // Far away from all players
+    for (int i = 0; i != 100; ++i)
+      {
+        add_projectile(g.get_game(), projectile(coordinate(-5000.0, -5000.0), 0.0));
+      }
+    g.show();
+    assert(g.get_drawables().get_n_items() > 100);
+    assert(count_vertices(g.get_sprites()) == n_vertices);
+    // Right in front of the last view drawn
+    const coordinate c{g.get_drawn_player_position(2)};
+    add_projectile(g.get_game(), projectile(c, 0.0));
+    g.show();
+    assert(count_vertices(g.get_sprites()) > n_vertices);
+  }
+  // A frame can be drawn from a snapshot,
+  // while the game ticks on another thread
+  {
+    game_view g;
+    action_log log;
+    simulation_thread s(g.get_game(), log, fixed_timestep(1000.0));
+    s.start();
+    for (int i = 0; i != 3; ++i)
+      {
+        g.show(s.get_newest_snapshot());
+      }
+    s.stop();
+    assert(g.get_sprites().get_n_batches() > 0);
+    assert(g.get_drawables().get_n_items() > 0);
+  }
+  // The player coordinates are only formatted again when these change
+  {
+    game_view g;
+    g.show();
+    g.show();
+    assert(g.get_hud().get_n_formats() == 1);
+    assert(!g.get_hud().get_text().empty());
+  }
+  // All ticks are logged, so the game can be replayed
+  {
+    game_view g;
+    g.get_game().get_player(1).get_action_set().insert(action_type::accelerate);
+    g.tick();
+    g.tick();
+    assert(g.get_action_log().get_n_ticks() == 2);
+    replay_engine r(g.get_action_log());
+    r.run();
+    assert(!r.has_diverged());
+  }
   #endif
 }
 
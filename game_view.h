@@ -3,11 +3,19 @@
 
 #ifndef LOGIC_ONLY // that is, not compiled on GitHub Actions
 
+#include "action_log.h"
+#include "background_layer.h"
+#include "drawable_grid.h"
+#include "fixed_timestep.h"
 #include "game.h"
 #include "game_resources.h"
 #include "game_options.h"
+#include "hud.h"
 #include <SFML/Graphics.hpp>
 #include "key_action_map.h"
+#include "render_snapshot.h"
+#include "simulation_thread.h"
+#include "sprite_batch.h"
 
 /// The game's main window
 /// Displays the game class
@@ -21,12 +29,31 @@ public:
   /// Show one frame
   void show() noexcept;
 
-  /// Draws players
-  void draw_players() noexcept;
+  /// Show one frame of a snapshot of the game, which can be
+  /// taken on another thread while the game ticks there
+  void show(const render_snapshot& s) noexcept;
 
-  /// Run the game until the window is closed
+  /// Adds the players to the sprites
+  void draw_players(const render_snapshot& s) noexcept;
+
+  /// Run the game until the window is closed.
+  /// The game ticks at the tick rate of the options,
+  /// independent of the frame rate.
+  /// If the options say so, the game ticks on a thread of its own
   void exec() noexcept;
 
+  /// Do one tick of the game, remembering where the players and shelters were
+  void tick();
+
+  /// Set how far the frame is from the latest tick towards the next one,
+  /// from zero to one. The players, projectiles and shelters are drawn
+  /// that far from where they were before the latest tick
+  void set_interpolation_alpha(const double alpha) noexcept { m_alpha = alpha; }
+
+  /// Get the position a player is drawn at, which is between its
+  /// positions before and after the latest tick
+  coordinate get_drawn_player_position(const int i) const;
+
   /// Get const reference to m_game_options
   const game_options& get_options() const noexcept {return m_options;}
 
@@ -40,6 +67,22 @@ public:
   ///Gets a ref to m_game
   game& get_game() noexcept {return m_game; }
 
+  /// Get the background, which is built upon the first frame
+  const background_layer& get_background() const noexcept { return m_background; }
+
+  /// Get the heads-up display with the coordinates of the players
+  const hud& get_hud() const noexcept { return m_hud; }
+
+  /// Get the sprites of the last view drawn
+  const sprite_batch& get_sprites() const noexcept { return m_sprites; }
+
+  /// Get the players, food, projectiles and shelters to draw,
+  /// indexed upon each frame
+  const drawable_grid& get_drawables() const noexcept { return m_drawables; }
+
+  /// Get the log of the actions of all ticks so far, to replay the game
+  const action_log& get_action_log() const noexcept { return m_action_log; }
+
   ///Gets the const reference to the vector of sf::Views m_v_views
   const std::vector<sf::View>& get_v_views() const noexcept {return  m_v_views; }
 
@@ -77,23 +120,93 @@ private:
   /// The options of the game
   game_options m_options;
 
+  /// Where the players and shelters were before the latest tick
+  previous_state m_previous;
+
+  /// How far the frame is from the latest tick towards the next one,
+  /// one if the players are drawn at their current position
+  double m_alpha = 1.0;
+
+  /// The actions of all ticks so far
+  action_log m_action_log;
+
+  /// The background, kept between frames
+  background_layer m_background;
+
+  /// The sprites of the view being drawn, one batch per texture
+  sprite_batch m_sprites;
+
+  /// The players, food, projectiles and shelters to draw, in that order,
+  /// so that each view finds the ones it can see
+  drawable_grid m_drawables;
+
+  /// The index of the first food item in m_drawables,
+  /// the players come before it
+  int m_first_food = 0;
+
+  /// The index of the first projectile in m_drawables
+  int m_first_projectile = 0;
+
+  /// The index of the first shelter in m_drawables
+  int m_first_shelter = 0;
+
+  /// The indices in m_drawables of the things the view being drawn can see,
+  /// in increasing order
+  std::vector<int> m_visible;
+
+  /// The text with the player coordinates, formatted when these change
+  hud m_hud;
+
+  /// The text of m_hud, which keeps its glyphs between frames
+  sf::Text m_hud_text;
+
+  /// The snapshot of the game shown, when the game ticks on this thread
+  render_snapshot m_snapshot;
+
+  /// The thread that ticks the game, while 'exec' runs it,
+  /// nullptr if the game ticks on this thread
+  simulation_thread* m_simulation = nullptr;
+
+  /// The key-action maps of the players, while the simulation thread runs
+  std::vector<key_action_map> m_input_kams;
+
+  /// The actions of the players, while the simulation thread runs
+  std::vector<action_set> m_input_actions;
+
   ///Draws the background
   void draw_background() noexcept;
 
-  ///Draws food
-  void draw_food() noexcept;
+  /// Puts the players, food, projectiles and shelters in m_drawables
+  void index_drawables(const render_snapshot& s);
+
+  /// Run the game until the window is closed,
+  /// with the game ticking on a thread of its own
+  void exec_threaded() noexcept;
+
+  /// Pass a key press or release to the simulation thread
+  void set_simulation_input(const sf::Event& event) noexcept;
+
+  /// Finds the things a view can see, and puts these in m_visible
+  void find_visible(const sf::View& view);
+
+  ///Adds food to the sprites
+  void draw_food(const render_snapshot& s) noexcept;
+
+  /// Adds the projectiles to the sprites
+  void draw_projectiles(const render_snapshot& s) noexcept;
 
-  /// Draws projectiles
-  void draw_projectiles() noexcept;
+  /// Adds the shelters to the sprites
+  void draw_shelters(const render_snapshot& s) noexcept;
 
-  /// Draws shelters
-  void draw_shelters() noexcept;
+  /// Draws the players, food, projectiles and shelters,
+  /// with one draw call per texture
+  void draw_sprites(const render_snapshot& s) noexcept;
 
   /// Set fourth view for players coordinates
   void set_player_coords_view() noexcept;
 
   /// Draw player coordinates
-  void draw_player_coords() noexcept;
+  void draw_player_coords(const render_snapshot& s) noexcept;
 };
 
 /// Count the number of projectiles
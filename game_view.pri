@@ -1,12 +1,16 @@
 # Files
 HEADERS += \
+    $$PWD/background_layer.h \
     $$PWD/game_view.h \
     $$PWD/menu_view.h \
     $$PWD/options_view.h \
+    $$PWD/sprite_batch.h \
 
 
 SOURCES += \
+    $$PWD/background_layer.cpp \
     $$PWD/game_view.cpp \
     $$PWD/menu_view.cpp \
     $$PWD/options_view.cpp \
+    $$PWD/sprite_batch.cpp \
 
@@ -0,0 +1,118 @@
+// The headless runner: runs a game without a window and measures
+// the tick throughput. Use 'game_headless.pro' to build it, e.g.
+//
+//   ./game_headless --players 50 --food 1000 --ticks 10000 --seed 42
+//
+// With '--games', it runs an ensemble of games on all cores instead
+// and measures the game throughput, e.g.
+//
+//   ./game_headless --games 1000 --threads 8 --players 10 --ticks 2000
+//
+// With '--replay', it replays a recorded game as fast as possible
+// and shows if the replay diverges from the recording, e.g.
+//
+//   ./game_headless --replay game.actions
+//
+// With '--profile', it also measures each phase of each tick and writes
+// the measurements as a Chrome trace and as CSV, e.g.
+//
+//   ./game_headless --players 50 --profile phases
+//
+// writes 'phases.json' and 'phases.csv'
+
+#include "ensemble_runner.h"
+#include "headless_runner.h"
+#include "replay_engine.h"
+#include "tick_profiler.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+/// The number of allocations done since the program started
+std::atomic<std::size_t> n_allocations{0};
+
+std::size_t count_allocations()
+{
+  return n_allocations.load();
+}
+
+// Count every allocation. operator new[] calls this operator new as well
+void* operator new(std::size_t size)
+{
+  ++n_allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+int main(int argc, char **argv)
+{
+  const std::vector<std::string> args(argv, argv + argc);
+  if (args.size() > 1 && args[1] == "--help")
+    {
+      std::cout << "Usage: " << args[0] << " [--players n] [--food n] [--shelters n]"
+                << " [--projectiles n] [--seed n] [--ticks n]"
+                << " [--games n [--threads n]] [--profile name]\n"
+                << "       " << args[0] << " --replay file\n";
+      return 0;
+    }
+  try
+  {
+    if (args.size() == 3 && args[1] == "--replay")
+      {
+        std::ifstream f(args[2], std::ios::binary);
+        if (!f) throw std::invalid_argument("Cannot open '" + args[2] + "'");
+        const action_log log = load_action_log(f);
+        replay_engine e(log);
+        e.run();
+        write_replay_report(std::cout, e);
+        return e.has_diverged() ? 1 : 0;
+      }
+    if (std::count(std::begin(args), std::end(args), "--games"))
+      {
+        ensemble_runner e(parse_ensemble_args(args));
+        e.run();
+        write_ensemble_report(std::cout, e);
+        return 0;
+      }
+    // Take out the profile flag, leave the rest to the headless runner
+    std::vector<std::string> runner_args(args);
+    std::string profile_name;
+    const auto profile_flag = std::find(std::begin(runner_args), std::end(runner_args), "--profile");
+    if (profile_flag != std::end(runner_args))
+      {
+        if (profile_flag + 1 == std::end(runner_args))
+          {
+            throw std::invalid_argument("Flag '--profile' has no value");
+          }
+        profile_name = *(profile_flag + 1);
+        runner_args.erase(profile_flag, profile_flag + 2);
+      }
+    headless_runner r(parse_headless_args(runner_args), count_allocations);
+    tick_profiler profiler;
+    if (!profile_name.empty()) r.get_game().set_profiler(&profiler);
+    r.run();
+    write_report(std::cout, r);
+    if (!profile_name.empty())
+      {
+        std::ofstream trace(profile_name + ".json");
+        write_chrome_trace(trace, profiler);
+        std::ofstream csv(profile_name + ".csv");
+        write_csv(csv, profiler);
+      }
+  }
+  catch (const std::invalid_argument& e)
+  {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,363 @@
+#include "headless_runner.h"
+#include "action_type.h"
+#include "environment.h"
+#include "projectile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+headless_options::headless_options(const int n_players,
+                                   const int n_food,
+                                   const int n_shelters,
+                                   const int n_projectiles,
+                                   const int seed,
+                                   const int n_ticks):
+  m_n_players{n_players},
+  m_n_food{n_food},
+  m_n_shelters{n_shelters},
+  m_n_projectiles{n_projectiles},
+  m_seed{seed},
+  m_n_ticks{n_ticks}
+{
+  if (m_n_players < 0 || m_n_food < 0 || m_n_shelters < 0
+      || m_n_projectiles < 0 || m_n_ticks < 0)
+    {
+      throw std::invalid_argument("Headless options cannot be negative");
+    }
+}
+
+int to_int(const std::string& flag, const std::string& value)
+{
+  std::size_t n_chars_read = 0;
+  int i = 0;
+  try
+  {
+    i = std::stoi(value, &n_chars_read);
+  }
+  catch (const std::exception&)
+  {
+    throw std::invalid_argument("Value of '" + flag + "' is not a number: '" + value + "'");
+  }
+  if (n_chars_read != value.size())
+    {
+      throw std::invalid_argument("Value of '" + flag + "' is not a number: '" + value + "'");
+    }
+  return i;
+}
+
+headless_options parse_headless_args(const std::vector<std::string>& args)
+{
+  const headless_options defaults;
+  int n_players = defaults.get_n_players();
+  int n_food = defaults.get_n_food();
+  int n_shelters = defaults.get_n_shelters();
+  int n_projectiles = defaults.get_n_projectiles();
+  int seed = defaults.get_seed();
+  int n_ticks = defaults.get_n_ticks();
+
+  // The first argument is the path of the executable
+  for (std::size_t i = 1; i < args.size(); i += 2)
+    {
+      const std::string& flag = args[i];
+      if (i + 1 == args.size())
+        {
+          throw std::invalid_argument("Flag '" + flag + "' has no value");
+        }
+      const int value = to_int(flag, args[i + 1]);
+      if (flag == "--players") n_players = value;
+      else if (flag == "--food") n_food = value;
+      else if (flag == "--shelters") n_shelters = value;
+      else if (flag == "--projectiles") n_projectiles = value;
+      else if (flag == "--seed") seed = value;
+      else if (flag == "--ticks") n_ticks = value;
+      else throw std::invalid_argument("Unknown flag '" + flag + "'");
+    }
+  return headless_options(n_players, n_food, n_shelters, n_projectiles, seed, n_ticks);
+}
+
+game create_headless_game(const headless_options& options)
+{
+  const int n_enemies = 1;
+  game g(environment(),
+         options.get_n_players(),
+         0,
+         static_cast<std::size_t>(options.get_n_shelters()),
+         n_enemies,
+         options.get_n_food(),
+         options.get_seed());
+
+  std::mt19937& rng = g.get_rng();
+
+  // Spread the players over the environment, without touching a wall
+  for (auto& p : g.get_v_player())
+    {
+      const double r{p.get_diameter() / 2.0};
+      std::uniform_real_distribution<double> x(get_min_x(g) + r, get_max_x(g) - r);
+      std::uniform_real_distribution<double> y(get_min_y(g) + r, get_max_y(g) - r);
+      p.place_to_position(coordinate(x(rng), y(rng)));
+    }
+
+  for (int i = 0; i != options.get_n_food(); ++i)
+    {
+      place_nth_food_randomly(g, i);
+    }
+
+  if (options.get_n_projectiles() > static_cast<int>(g.get_max_n_projectiles()))
+    {
+      throw std::invalid_argument(
+        "A game has at most " + std::to_string(g.get_max_n_projectiles()) + " projectiles"
+      );
+    }
+  std::uniform_real_distribution<double> x(get_min_x(g), get_max_x(g));
+  std::uniform_real_distribution<double> y(get_min_y(g), get_max_y(g));
+  std::uniform_real_distribution<double> direction(0.0, 2.0 * M_PI);
+  for (int i = 0; i != options.get_n_projectiles(); ++i)
+    {
+      const coordinate c(x(rng), y(rng));
+      add_projectile(g, projectile(c, direction(rng)));
+    }
+  return g;
+}
+
+void apply_scripted_actions(game& g, const int tick)
+{
+  const int n_players = static_cast<int>(g.get_v_player().size());
+  for (int i = 0; i != n_players; ++i)
+    {
+      player& p = g.get_player(i);
+      p.get_action_set().clear();
+      add_action(p, action_type::accelerate);
+
+      // Each player turns left, goes straight, turns right, goes straight,
+      // for 50 ticks each. Players start at a different phase
+      const int phase = ((tick / 50) + i) % 4;
+      if (phase == 0) add_action(p, action_type::turn_left);
+      if (phase == 2) add_action(p, action_type::turn_right);
+
+      // Each player shoots once every 100 ticks
+      if ((tick + (7 * i)) % 100 == 0) add_action(p, action_type::shoot);
+    }
+}
+
+headless_runner::headless_runner(const headless_options& options,
+                                 std::size_t (*count_allocations)()):
+  m_options{options},
+  m_game{create_headless_game(options)},
+  m_count_allocations{count_allocations},
+  m_n_allocations{0}
+{
+  m_tick_durations.reserve(static_cast<std::size_t>(options.get_n_ticks()));
+}
+
+std::int64_t headless_runner::tick()
+{
+  apply_scripted_actions(m_game, m_game.get_n_ticks());
+
+  const std::size_t n_allocations_before{
+    m_count_allocations ? m_count_allocations() : 0
+  };
+  const auto start = std::chrono::steady_clock::now();
+  m_game.tick();
+  const auto end = std::chrono::steady_clock::now();
+  if (m_count_allocations)
+    {
+      m_n_allocations += m_count_allocations() - n_allocations_before;
+    }
+
+  const std::int64_t duration{
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+  };
+  m_tick_durations.push_back(duration);
+  return duration;
+}
+
+void headless_runner::run()
+{
+  while (static_cast<int>(m_tick_durations.size()) < m_options.get_n_ticks())
+    {
+      tick();
+    }
+}
+
+std::int64_t get_percentile(std::vector<std::int64_t> values, const double p)
+{
+  assert(p >= 0.0);
+  assert(p <= 100.0);
+  if (values.empty()) return 0;
+  std::sort(std::begin(values), std::end(values));
+  const double rank{std::ceil(p / 100.0 * static_cast<double>(values.size()))};
+  const std::size_t index{rank < 1.0 ? 0 : static_cast<std::size_t>(rank) - 1};
+  return values[std::min(index, values.size() - 1)];
+}
+
+double get_ticks_per_second(const std::vector<std::int64_t>& tick_durations)
+{
+  const std::int64_t total_ns{
+    std::accumulate(std::begin(tick_durations), std::end(tick_durations), std::int64_t(0))
+  };
+  if (total_ns == 0) return 0.0;
+  return static_cast<double>(tick_durations.size()) / (static_cast<double>(total_ns) * 1.0e-9);
+}
+
+void write_report(std::ostream& os, const headless_runner& r)
+{
+  const headless_options& o = r.get_options();
+  const std::vector<std::int64_t>& d = r.get_tick_durations();
+  os << "players: " << o.get_n_players()
+     << ", food: " << o.get_n_food()
+     << ", shelters: " << o.get_n_shelters()
+     << ", projectiles: " << o.get_n_projectiles()
+     << ", seed: " << o.get_seed() << '\n'
+     << "ticks: " << d.size() << '\n'
+     << "ticks/second: " << get_ticks_per_second(d) << '\n'
+     << "ns/tick p50: " << get_percentile(d, 50.0) << '\n'
+     << "ns/tick p90: " << get_percentile(d, 90.0) << '\n'
+     << "ns/tick p99: " << get_percentile(d, 99.0) << '\n'
+     << "ns/tick max: " << get_percentile(d, 100.0) << '\n'
+     << "projectiles at end: " << count_n_projectiles(r.get_game()) << '\n';
+  os << "allocations: " << r.get_n_allocations();
+  if (!d.empty())
+    {
+      os << " (" << static_cast<double>(r.get_n_allocations()) / static_cast<double>(d.size())
+         << " per tick)";
+    }
+  os << '\n';
+}
+
+void test_headless_runner() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // Default options
+  {
+    const headless_options o;
+    assert(o.get_n_players() == 3);
+    assert(o.get_n_food() == 1);
+    assert(o.get_n_shelters() == 42);
+    assert(o.get_n_projectiles() == 0);
+    assert(o.get_seed() == 0);
+    assert(o.get_n_ticks() == 1000);
+  }
+  // Options are read from the command line, others keep their default value
+  {
+    const headless_options o = parse_headless_args(
+      {"path", "--players", "10", "--seed", "42", "--projectiles", "5"}
+    );
+    assert(o.get_n_players() == 10);
+    assert(o.get_seed() == 42);
+    assert(o.get_n_projectiles() == 5);
+    assert(o.get_n_food() == headless_options().get_n_food());
+  }
+  // Unknown flags, missing values and non-numbers are rejected
+  {
+    const std::vector<std::vector<std::string>> v_args{
+      {"path", "--nonsense", "1"},
+      {"path", "--ticks"},
+      {"path", "--ticks", "many"},
+      {"path", "--ticks", "12a"},
+      {"path", "--ticks", "-1"}
+    };
+    for (const auto& args : v_args)
+      {
+        bool has_thrown{false};
+        try
+        {
+          parse_headless_args(args);
+        }
+        catch (const std::invalid_argument&)
+        {
+          has_thrown = true;
+        }
+        assert(has_thrown);
+      }
+  }
+  // A headless game has all players inside the environment
+  {
+    const headless_options o(20, 10, 5, 7);
+    const game g = create_headless_game(o);
+    assert(static_cast<int>(g.get_v_player().size()) == 20);
+    assert(count_n_projectiles(g) == 7);
+    for (const auto& p : g.get_v_player())
+      {
+        assert(!hits_wall(p, g.get_env()));
+      }
+  }
+  // A headless game cannot start with more projectiles than a game can have
+  {
+    bool has_thrown{false};
+    try
+    {
+      create_headless_game(headless_options(3, 1, 0, 100000));
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+  // The script makes all players accelerate and sometimes shoot
+  {
+    game g;
+    apply_scripted_actions(g, 0);
+    for (const auto& p : g.get_v_player())
+      {
+        assert(p.get_action_set().count(action_type::accelerate));
+      }
+    assert(g.get_player(0).get_action_set().count(action_type::shoot));
+    apply_scripted_actions(g, 1);
+    assert(!g.get_player(0).get_action_set().count(action_type::shoot));
+  }
+  // A runner does all the ticks and measures each of these
+  {
+    const int n_ticks{10};
+    headless_runner r(headless_options(3, 1, 42, 0, 0, n_ticks));
+    r.run();
+    assert(r.get_game().get_n_ticks() == n_ticks);
+    assert(static_cast<int>(r.get_tick_durations().size()) == n_ticks);
+    assert(r.get_n_allocations() == 0); // Not counted
+  }
+  // Two runs with the same options give the same game
+  {
+    const headless_options o(5, 10, 0, 10, 123, 200);
+    headless_runner a(o);
+    headless_runner b(o);
+    a.run();
+    b.run();
+    for (int i = 0; i != o.get_n_players(); ++i)
+      {
+        assert(a.get_game().get_player(i).get_position() == b.get_game().get_player(i).get_position());
+      }
+  }
+  // Percentiles use the nearest rank
+  {
+    std::vector<std::int64_t> v(100);
+    std::iota(std::begin(v), std::end(v), 1);
+    std::reverse(std::begin(v), std::end(v));
+    assert(get_percentile(v, 50.0) == 50);
+    assert(get_percentile(v, 99.0) == 99);
+    assert(get_percentile(v, 100.0) == 100);
+    assert(get_percentile(v, 0.0) == 1);
+    assert(get_percentile({}, 50.0) == 0);
+  }
+  // Two ticks of half a second each is two ticks per second
+  {
+    const std::vector<std::int64_t> v{500000000, 500000000};
+    assert(std::abs(get_ticks_per_second(v) - 2.0) < 0.0001);
+    assert(get_ticks_per_second({}) == 0.0);
+  }
+  // A report can be written
+  {
+    headless_runner r(headless_options(3, 1, 42, 0, 0, 2));
+    r.run();
+    std::stringstream s;
+    write_report(s, r);
+    assert(!s.str().empty());
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,106 @@
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include "game.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// The settings of a headless simulation run
+class headless_options
+{
+public:
+  headless_options(const int n_players = 3,
+                   const int n_food = 1,
+                   const int n_shelters = 42,
+                   const int n_projectiles = 0,
+                   const int seed = 0,
+                   const int n_ticks = 1000);
+
+  int get_n_players() const noexcept { return m_n_players; }
+  int get_n_food() const noexcept { return m_n_food; }
+  int get_n_shelters() const noexcept { return m_n_shelters; }
+  int get_n_projectiles() const noexcept { return m_n_projectiles; }
+  int get_seed() const noexcept { return m_seed; }
+  int get_n_ticks() const noexcept { return m_n_ticks; }
+
+private:
+  int m_n_players;
+  int m_n_food;
+  int m_n_shelters;
+  int m_n_projectiles;
+  int m_seed;
+  int m_n_ticks;
+};
+
+/// Convert the value of a command-line flag to an int.
+/// Throws std::invalid_argument if the value is not a number
+int to_int(const std::string& flag, const std::string& value);
+
+/// Read the headless options from the command-line arguments,
+/// e.g. {"path", "--players", "10", "--ticks", "5000"}.
+/// Throws std::invalid_argument upon an unknown flag or a bad value
+headless_options parse_headless_args(const std::vector<std::string>& args);
+
+/// Create a game for a headless run: the players, food items
+/// and projectiles are spread over the environment, using the seed
+game create_headless_game(const headless_options& options);
+
+/// Set the actions of the players for the given tick.
+/// The script only depends on the player index and the tick,
+/// so every run with the same options does the same thing
+void apply_scripted_actions(game& g, const int tick);
+
+/// Runs a game without a game_view and measures each tick
+class headless_runner
+{
+public:
+  /// @param options the settings of the run
+  /// @param count_allocations function that returns the number of
+  ///   allocations done so far, nullptr if these are not counted
+  headless_runner(const headless_options& options,
+                  std::size_t (*count_allocations)() = nullptr);
+
+  /// Apply the scripted actions and do one game::tick().
+  /// Returns the duration of game::tick() in nanoseconds
+  std::int64_t tick();
+
+  /// Do all the ticks in the options
+  void run();
+
+  const game& get_game() const noexcept { return m_game; }
+  game& get_game() noexcept { return m_game; }
+
+  const headless_options& get_options() const noexcept { return m_options; }
+
+  /// The duration of each game::tick(), in nanoseconds
+  const std::vector<std::int64_t>& get_tick_durations() const noexcept { return m_tick_durations; }
+
+  /// The number of allocations done by all game::tick() calls,
+  /// zero if allocations are not counted
+  std::size_t get_n_allocations() const noexcept { return m_n_allocations; }
+
+private:
+  headless_options m_options;
+  game m_game;
+  std::size_t (*m_count_allocations)();
+  std::vector<std::int64_t> m_tick_durations;
+  std::size_t m_n_allocations;
+};
+
+/// Get the p-th percentile (p in [0, 100]) of the values,
+/// using the nearest-rank method. Returns zero if there are no values
+std::int64_t get_percentile(std::vector<std::int64_t> values, const double p);
+
+/// Get the number of ticks per second, from the tick durations in nanoseconds
+double get_ticks_per_second(const std::vector<std::int64_t>& tick_durations);
+
+/// Write the throughput, the percentiles of the tick durations and the
+/// allocation counts of a finished run
+void write_report(std::ostream& os, const headless_runner& r);
+
+/// Test the headless runner
+void test_headless_runner();
+
+#endif // HEADLESS_RUNNER_H
@@ -0,0 +1,128 @@
+#include "hud.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+
+hud::hud():
+  m_food_x{0.0},
+  m_food_y{0.0},
+  m_n_formats{0}
+{
+  // Enough for a few players, so formatting does not allocate
+  m_text.reserve(1024);
+}
+
+bool hud::is_outdated(const render_snapshot& s) const noexcept
+{
+  if (m_n_formats == 0 || s.m_players.size() != m_names.size()) return true;
+  if (std::trunc(s.m_food_position.get_x()) != m_food_x
+      || std::trunc(s.m_food_position.get_y()) != m_food_y)
+    {
+      return true;
+    }
+  for (std::size_t i = 0; i != m_names.size(); ++i)
+    {
+      const player_snapshot& p = s.m_players[i];
+      if (std::trunc(p.m_position.get_x()) != m_xs[i]
+          || std::trunc(p.m_position.get_y()) != m_ys[i]
+          || p.m_name != m_names[i])
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool hud::update(const render_snapshot& s)
+{
+  if (!is_outdated(s)) return false;
+  const std::size_t n_players{s.m_players.size()};
+  m_names.resize(n_players);
+  m_xs.resize(n_players);
+  m_ys.resize(n_players);
+  for (std::size_t i = 0; i != n_players; ++i)
+    {
+      const player_snapshot& p = s.m_players[i];
+      m_names[i] = p.m_name;
+      m_xs[i] = std::trunc(p.m_position.get_x());
+      m_ys[i] = std::trunc(p.m_position.get_y());
+    }
+  m_food_x = std::trunc(s.m_food_position.get_x());
+  m_food_y = std::trunc(s.m_food_position.get_y());
+  format();
+  return true;
+}
+
+void hud::format()
+{
+  m_text.clear();
+  char line[256];
+  for (std::size_t i = 0; i != m_names.size(); ++i)
+    {
+      const char* name{m_names[i].c_str()};
+      const int n{std::snprintf(line, sizeof(line), "Player %s x = %f\nPlayer %s y = %f\n\n",
+                                name, m_xs[i], name, m_ys[i])};
+      if (n > 0) m_text.append(line, std::min(static_cast<std::size_t>(n), sizeof(line) - 1));
+    }
+  const int n{std::snprintf(line, sizeof(line), "Food x = %fy = %f\n\n", m_food_x, m_food_y)};
+  if (n > 0) m_text.append(line, std::min(static_cast<std::size_t>(n), sizeof(line) - 1));
+  ++m_n_formats;
+}
+
+void test_hud() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  render_snapshot s;
+  s.m_players.resize(2);
+  s.m_players[0].m_name = "0";
+  s.m_players[0].m_position = coordinate(300.7, 400.2);
+  s.m_players[1].m_name = "1";
+  s.m_players[1].m_position = coordinate(-12.5, 3.0);
+  s.m_food_position = coordinate(2000.0, 1000.0);
+  // The text shows the truncated coordinates, as std::to_string does
+  {
+    hud h;
+    assert(h.update(s));
+    const std::string expected{
+      "Player 0 x = " + std::to_string(std::trunc(300.7))
+      + "\nPlayer 0 y = " + std::to_string(std::trunc(400.2)) + "\n\n"
+      + "Player 1 x = " + std::to_string(std::trunc(-12.5))
+      + "\nPlayer 1 y = " + std::to_string(std::trunc(3.0)) + "\n\n"
+      + "Food x = " + std::to_string(std::trunc(2000.0))
+      + "y = " + std::to_string(std::trunc(1000.0)) + "\n\n"
+    };
+    assert(h.get_text() == expected);
+    assert(h.get_n_formats() == 1);
+  }
+  // The text is only formatted again if a shown value changes
+  {
+    hud h;
+    render_snapshot t{s};
+    assert(h.update(t));
+    assert(!h.update(t));
+    // Within the same unit, the text stays the same
+    t.m_players[0].m_position = coordinate(300.9, 400.0);
+    assert(!h.update(t));
+    assert(h.get_n_formats() == 1);
+    t.m_players[0].m_position = coordinate(301.0, 400.0);
+    assert(h.update(t));
+    t.m_food_position = coordinate(0.0, 0.0);
+    assert(h.update(t));
+    t.m_players.pop_back();
+    assert(h.update(t));
+    assert(h.get_n_formats() == 4);
+  }
+  // Formatting again keeps the memory of the text
+  {
+    hud h;
+    h.update(s);
+    const char* const before{h.get_text().data()};
+    render_snapshot t{s};
+    t.m_players[1].m_position = coordinate(1.0, 1.0);
+    assert(h.update(t));
+    assert(h.get_text().data() == before);
+  }
+#endif // no tests in release
+}
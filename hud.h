@@ -0,0 +1,52 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include "render_snapshot.h"
+#include <string>
+#include <vector>
+
+/// The heads-up display: the text with the coordinates
+/// of the players and of the food.
+/// The text is only formatted again when a shown value changes,
+/// into a buffer that keeps its memory between frames
+class hud
+{
+public:
+  hud();
+
+  /// Show the values of a snapshot.
+  /// Returns true if the text changed
+  bool update(const render_snapshot& s);
+
+  /// Get the text to show
+  const std::string& get_text() const noexcept { return m_text; }
+
+  /// The number of times the text was formatted
+  int get_n_formats() const noexcept { return m_n_formats; }
+
+private:
+  /// The names of the players shown
+  std::vector<std::string> m_names;
+
+  /// The player coordinates shown, truncated
+  std::vector<double> m_xs;
+  std::vector<double> m_ys;
+
+  /// The food coordinates shown, truncated
+  double m_food_x;
+  double m_food_y;
+
+  std::string m_text;
+  int m_n_formats;
+
+  /// Does the text show other values than those of a snapshot?
+  bool is_outdated(const render_snapshot& s) const noexcept;
+
+  /// Format the text from the shown values
+  void format();
+};
+
+/// Test the hud class
+void test_hud();
+
+#endif // HUD_H
@@ -1,15 +1,27 @@
+#include "action_log.h"
+#include "action_set.h"
+#include "background_layer.h"
+#include "binary_io.h"
 #include "coordinate.h"
+#include "drawable_grid.h"
 #include "enemy.h"
+#include "ensemble_runner.h"
 #include "environment.h"
 #include "environment_type.h"
+#include "fast_rng.h"
+#include "fixed_timestep.h"
 #include "enemy_behavior_type.h"
 #include "food.h"
+#include "food_grid.h"
+#include "food_placement.h"
 #include "food_type.h"
 #include "food_state.h"
 #include "game.h"
 #include "game_options.h"
 #include "game_resources.h"
 #include "game_view.h"
+#include "headless_runner.h"
+#include "hud.h"
 #include "key_action_map.h"
 #include "menu_button.h"
 #include "menu.h"
@@ -22,14 +34,31 @@
 #include "program_state.h"
 #include "player_state.h"
 #include "projectile.h"
+#include "projectile_hit.h"
+#include "projectile_pool.h"
 #include "read_only.h"
+#include "render_snapshot.h"
+#include "replay_engine.h"
+#include "rolling_histogram.h"
+#include "simulation_thread.h"
+#include "snapshot.h"
 #include "sound_type.h"
+#include "spatial_grid.h"
+#include "sprite_batch.h"
+#include "state_hash.h"
+#include "texture_atlas.h"
+#include "tick_phase.h"
+#include "tick_profiler.h"
+#include "timing_wheel.h"
+#include "triple_buffer.h"
 #include "optional.h"
 
 #include <SFML/Graphics.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <fstream>
 #include <iostream>
 
 
@@ -40,6 +69,8 @@ bool is_valid_arg(const std::string& s)
       || s == "--no-sound"
       || s == "--about"
       || s == "--options"
+      || s == "--record"
+      || s == "--threaded"
       ;
 }
 
@@ -66,6 +97,8 @@ void test_main()
   assert(is_valid_arg("--menu"));
   assert(are_args_valid({"path","--about"}));
   assert(is_valid_arg("--options"));
+  assert(are_args_valid({"path", "--no-sound", "--record"}));
+  assert(are_args_valid({"path", "--no-sound", "--threaded"}));
 }
 
 /// All tests are called from here, only in debug mode
@@ -73,6 +106,7 @@ void test()
 {
 #ifndef NDEBUG
   test_optional();
+  test_action_set();
   test_action_type();
   test_player_shape();
   test_player();
@@ -82,7 +116,12 @@ void test()
   test_enemy_behavior_type();
   test_environment();
   test_individual_type();
+  test_fast_rng();
+  test_fixed_timestep();
+  test_drawable_grid();
   test_food();
+  test_food_grid();
+  test_food_placement();
   test_food_type();
   test_food_state();
   test_key_action_map();
@@ -92,16 +131,37 @@ void test()
   test_color();
   test_projectile_type();
   test_projectile();
+  test_projectile_hit();
+  test_projectile_pool();
   test_program_state();
   test_player_state();
   test_player_factory();
   test_read_only();
   test_coordinate();
   test_sound_type();
+  test_headless_runner();
+  test_hud();
+  test_ensemble_runner();
+  test_spatial_grid();
+  test_binary_io();
+  test_state_hash();
+  test_texture_atlas();
+  test_action_log();
+  test_replay_engine();
+  test_snapshot();
+  test_tick_phase();
+  test_rolling_histogram();
+  test_tick_profiler();
+  test_timing_wheel();
+  test_triple_buffer();
+  test_render_snapshot();
+  test_simulation_thread();
   test_main();
 
 #ifndef LOGIC_ONLY
+  test_background_layer();
   test_game_view();
+  test_sprite_batch();
   test_game_resources();
 #endif // LOGIC_ONLY
 #endif
@@ -143,8 +203,9 @@ int main(int argc, char **argv) //!OCLINT tests may be long
       duration<double> time = high_resolution_clock::now() - start;
       while( time.count() < max_duration)
         {
+          // One tick per frame, to measure both as fast as possible
           v.process_events();
-          v.get_game().tick();
+          v.tick();
           v.show();
           time =  high_resolution_clock::now() - start;
         }
@@ -173,8 +234,20 @@ int main(int argc, char **argv) //!OCLINT tests may be long
     {
       music_off(options);
     }
+  // Tick the game on a thread of its own, so slow frames do not slow it down
+  if (std::count(std::begin(args), std::end(args), "--threaded"))
+    {
+      options.set_simulating_in_thread(true);
+    }
   game_view v(options);
   assert(options == v.get_options());
   v.exec();
+
+  // Save the actions, to replay the game with 'game_headless --replay'
+  if (std::count(std::begin(args), std::end(args), "--record"))
+    {
+      std::ofstream f("game.actions", std::ios::binary);
+      save(v.get_action_log(), f);
+    }
 #endif // LOGIC_ONLY
 }
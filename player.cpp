@@ -15,7 +15,7 @@ player::player(const coordinate c,
                const double size,
                const double turn_rate,
                const color &any_color,
-               const std::string& ID)
+               const int ID)
     : m_color{any_color},
       m_ID{ID},
       m_c{c},
@@ -28,16 +28,41 @@ player::player(const coordinate c,
       m_diameter{size},
       m_turn_rate{turn_rate}
 {
+    update_heading();
+}
 
+void player::set_direction(const double direction) noexcept
+{
+    m_direction_radians = direction;
+    update_heading();
 }
+
 //move a player
 void player::move() noexcept
 {
-    double new_x = m_c.get_x() + cos(m_direction_radians) * m_player_speed;
-    double new_y = m_c.get_y() + sin(m_direction_radians) * m_player_speed;
+    double new_x = m_c.get_x() + m_heading_x * m_player_speed;
+    double new_y = m_c.get_y() + m_heading_y * m_player_speed;
     m_c = coordinate(new_x, new_y);
 }
 
+void player::turn_left() noexcept
+{
+    m_direction_radians -= m_turn_rate;
+    update_heading();
+}
+
+void player::turn_right() noexcept
+{
+    m_direction_radians += m_turn_rate;
+    update_heading();
+}
+
+void player::update_heading() noexcept
+{
+    m_heading_x = std::cos(m_direction_radians);
+    m_heading_y = std::sin(m_direction_radians);
+}
+
 /// Get the X coordinate of the player
 double player::get_x() const noexcept { return m_c.get_x(); }
 
@@ -121,6 +146,29 @@ bool are_colliding(const player &lhs, const player &rhs) noexcept
     return actual_distance < collision_distance;
 }
 
+void apply_inertia(std::vector<player>& players) noexcept
+{
+    for (auto& p : players)
+    {
+        // A player without speed moves zero and keeps zero speed
+        const double speed{p.get_speed()};
+        const double deceleration{p.get_deceleration()};
+        const double braked_speed{
+            speed > 0.0 ? speed + deceleration : (speed < 0.0 ? speed - deceleration : 0.0)
+        };
+        // Move, then brake, which moves again at the lower speed
+        double x{p.get_x()};
+        double y{p.get_y()};
+        x += p.get_heading_x() * speed;
+        y += p.get_heading_y() * speed;
+        x += p.get_heading_x() * braked_speed;
+        y += p.get_heading_y() * braked_speed;
+        p.set_x(x);
+        p.set_y(y);
+        p.set_speed(braked_speed);
+    }
+}
+
 int get_blueness(const player &p) noexcept { return p.get_color().get_blue(); }
 
 int get_greenness(const player &p) noexcept
@@ -207,7 +255,7 @@ void remove_action(player& p, action_type action) noexcept
     p.get_action_set().erase(action);
 }
 
-player create_player_with_id(const std::string& id)
+player create_player_with_id(const int id)
 
 {
     return player{
@@ -533,6 +581,31 @@ void test_player() //!OCLINT tests may be long
         assert(p.get_action_set().count(action));
     }
 
+    //A player moves in the direction it is facing, also after turning
+    {
+        player p;
+        p.accelerate();
+        p.turn_left();
+        p.turn_left();
+        p.turn_right();
+        assert(std::abs(p.get_heading_x() - std::cos(p.get_direction())) < 0.000001);
+        assert(std::abs(p.get_heading_y() - std::sin(p.get_direction())) < 0.000001);
+        const double x_before{get_x(p)};
+        const double y_before{get_y(p)};
+        p.move();
+        assert(std::abs(get_x(p) - x_before - (std::cos(p.get_direction()) * p.get_speed())) < 0.000001);
+        assert(std::abs(get_y(p) - y_before - (std::sin(p.get_direction()) * p.get_speed())) < 0.000001);
+    }
+
+    //A player that is set to face a direction moves in that direction
+    {
+        player p;
+        p.set_direction(0.0);
+        assert(p.get_direction() == 0.0);
+        assert(p.get_heading_x() == 1.0);
+        assert(p.get_heading_y() == 0.0);
+    }
+
     //A player can erase an action from its action set and keep the others
     {
         player p;
@@ -747,7 +820,7 @@ void test_player() //!OCLINT tests may be long
     ///A player has an ID
     ///#1
     {
-        const std::string id = "31415";
+        const int id = 31415;
         const player p = create_player_with_id(id);
         assert(p.get_ID() == id);
     }
@@ -857,6 +930,28 @@ void test_player() //!OCLINT tests may be long
     }
   #endif
 
+  // Inertia is the same as moving and braking each player
+  {
+    std::vector<player> players(3);
+    players[0].accelerate();
+    players[1].acc_backward();
+    players[1].turn_left();
+    std::vector<player> expected = players;
+    for (auto& p : expected)
+      {
+        if (p.get_speed() != 0.0)
+          {
+            p.move();
+            p.brake();
+          }
+      }
+    apply_inertia(players);
+    for (int i = 0; i != 3; ++i)
+      {
+        assert(players[i].get_position() == expected[i].get_position());
+        assert(players[i].get_speed() == expected[i].get_speed());
+      }
+  }
 #endif // no tests in release
 }
 
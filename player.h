@@ -1,15 +1,14 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include "action_set.h"
 #include "action_type.h"
 #include "color.h"
 #include "coordinate.h"
 #include "player_shape.h"
 #include "player_state.h"
-#include "read_only.h"
 #include <cmath>
 #include <vector>
-#include <set>
 
 
 class player
@@ -25,7 +24,7 @@ public:
            const double size = 100.0,
            const double turn_rate = 0.01,
            const color &any_color = color(),
-           const std::string& ID = "0");
+           const int ID = 0);
 
 
     /// Get the acceleration of the player
@@ -34,11 +33,14 @@ public:
     ///Get the backward acceleration of the player
     double get_acceleration_backward() const noexcept { return m_player_acc_backward; }
 
+    /// Get the deceleration of the player, which is negative
+    double get_deceleration() const noexcept { return m_player_deceleration; }
+
     ///Returns const ref to action set of the player
-    const std::set<action_type>& get_action_set() const noexcept {return m_action_set;}
+    const action_set& get_action_set() const noexcept {return m_action_set;}
 
     ///Returns const ref to action set of the player
-    std::set<action_type>& get_action_set() noexcept {return m_action_set;}
+    action_set& get_action_set() noexcept {return m_action_set;}
 
     /// Get the color of the player
     const color &get_color() const noexcept { return m_color; }
@@ -62,7 +64,7 @@ public:
     double get_diameter() const noexcept;
 
     ///Gets the ID of a player
-    std::string get_ID() const noexcept {return m_ID.get_value(); }
+    int get_ID() const noexcept {return m_ID; }
 
     /// Get the speed of the player
     double get_speed() const noexcept { return m_player_speed; }
@@ -73,9 +75,18 @@ public:
     /// Get the direction of player movement, in radians
     double get_direction() const noexcept;
 
+    /// Get the x component of the unit vector in the direction of the player
+    double get_heading_x() const noexcept { return m_heading_x; }
+
+    /// Get the y component of the unit vector in the direction of the player
+    double get_heading_y() const noexcept { return m_heading_y; }
+
     /// Get the player's health
     double get_health() const noexcept { return m_health; }
 
+    /// Get the angle, in radians, the player turns per tick when turning
+    double get_turn_rate() const noexcept { return m_turn_rate; }
+
 
     /// Is the player shooting?
     /// When a player shoots, 'm_is_shooting' is true for one tick.
@@ -119,11 +130,20 @@ public:
     /// Set a player y position
     void set_y(double y) noexcept { m_c.set_y(y); }
 
+    /// Set the speed of the player
+    void set_speed(double speed) noexcept { m_player_speed = speed; }
+
+    /// Set the direction of the player, in radians
+    void set_direction(const double direction) noexcept;
+
+    /// Set the health of the player
+    void set_health(const double health) noexcept { m_health = health; }
+
     /// Turn the player left
-    void turn_left() noexcept { m_direction_radians -= m_turn_rate; }
+    void turn_left() noexcept;
 
     /// Turn the player right
-    void turn_right() noexcept { m_direction_radians += m_turn_rate; }
+    void turn_right() noexcept;
 
     //move a player
     void move() noexcept;
@@ -148,7 +168,7 @@ private:
     color m_color;
 
   //The set of ongoing actions of a player
-    std::set<action_type> m_action_set;
+    action_set m_action_set;
 
     /// When a player shoots, 'm_is_shooting' is true for one tick.
     /// 'game' reads 'm_is_shooting' and if it is true,
@@ -157,8 +177,8 @@ private:
 
     bool m_is_shooting_stun_rocket{false};
 
-    ///ID of the player
-    read_only<std::string> m_ID;
+    ///ID of the player, its name is stored by the game
+    int m_ID;
 
     /// The coordinate of the player
     coordinate m_c;
@@ -193,6 +213,14 @@ private:
     /// The direction of player in radians
     double m_direction_radians = 270 * M_PI / 180;
 
+    /// The unit vector in the direction of the player,
+    /// only changes when the player turns
+    double m_heading_x;
+    double m_heading_y;
+
+    /// Set the unit vector to the direction of the player
+    void update_heading() noexcept;
+
     /// The rate at which the player turns
     double m_turn_rate;
 
@@ -207,6 +235,12 @@ void add_action(player& p, action_type action) noexcept;
 /// Checks if two players are colliding
 bool are_colliding(const player &p1, const player &p2) noexcept;
 
+/// Move all players that have a speed and slow them down,
+/// in the same way as player::move followed by player::brake.
+/// Uses the unit vectors of the players, so there is no
+/// trigonometry and no branching that stops vectorization
+void apply_inertia(std::vector<player>& players) noexcept;
+
 ///create a player with a set color
 player create_player_with_color(const color& in_color);
 
@@ -249,7 +283,7 @@ int get_colorhash(const player &p) noexcept;
 ///Removes an action from action set of the player
 void remove_action(player& p, action_type) noexcept;
 
-player create_player_with_id(const std::string& id);
+player create_player_with_id(const int id);
 
 /// Test the player class
 void test_player();
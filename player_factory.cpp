@@ -7,9 +7,9 @@ player_factory::player_factory()
 
 void test_player_factory()
 {
-
+#ifndef NDEBUG // no tests in release
     {
-        const std::string id = "31415";
+        const int id = 31415;
         player_factory f;
         f.set_id(id);
         const player p = f.create();
@@ -23,5 +23,5 @@ void test_player_factory()
 //      const player p = f.create();
 //      assert(p.get_ID() == id);
 //    }
-
+#endif // no tests in release
 }
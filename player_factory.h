@@ -4,12 +4,12 @@
 
 class player_factory
 {
-  std::string m_ID;
+  int m_ID = 0;
 
 public:
 
   player_factory();
-  void set_id(const std::string& ID){m_ID = ID;}
+  void set_id(const int ID){m_ID = ID;}
 
   player create() {return create_player_with_id(m_ID);}
 };
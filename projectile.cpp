@@ -5,26 +5,20 @@
 
 projectile::projectile(
   const coordinate c, const double direction, const projectile_type p,
-  const double radius, const std::string& owner_id)
-  : m_coordinate{c}, m_direction{direction}, m_projectile_type{p}, m_radius{radius}, m_owner_id{owner_id}
+  const double radius, const int owner_id)
+  : m_coordinate{c}, m_previous_coordinate{c}, m_direction{direction},
+    m_heading_x{std::cos(direction)}, m_heading_y{std::sin(direction)},
+    m_projectile_type{p}, m_radius{radius}, m_owner_id{owner_id}
 
 {
 }
 
-void projectile::move()
-{
-  m_coordinate.set_x(m_coordinate.get_x() + std::cos(m_direction));
-  m_coordinate.set_y(m_coordinate.get_y() + std::sin(m_direction));
-  //m_coordinate.move(m_direction);
-}
-
 void projectile::place(const coordinate& c)
 {
   m_coordinate = c;
+  m_previous_coordinate = c;
 }
 
-std::string projectile::get_owner_id() noexcept { return m_owner_id;}
-
 void test_projectile()
 {
   #ifndef NDEBUG // no tests in release
@@ -43,6 +37,46 @@ void test_projectile()
     assert(t == p.get_type());
     assert(r == p.get_radius());
   }
+  // A projectile has no owner by default
+  {
+    const coordinate c{0.0, 0.0};
+    assert(projectile(c).get_owner_id() == -1);
+    const int owner_id{2};
+    assert(projectile(c, 0.0, projectile_type::rocket, 100, owner_id).get_owner_id() == owner_id);
+  }
+  // A projectile moves one unit in its direction
+  {
+    const double d{0.7};
+    projectile p{coordinate{1.0, 2.0}, d};
+    p.move();
+    assert(std::abs(get_x(p) - (1.0 + std::cos(d))) < 0.000001);
+    assert(std::abs(get_y(p) - (2.0 + std::sin(d))) < 0.000001);
+  }
+  // A projectile knows where it was before its latest move
+  {
+    projectile p{coordinate{1.0, 2.0}, 0.7};
+    assert(p.get_previous_position() == coordinate(1.0, 2.0));
+    p.move();
+    p.increment_age();
+    const coordinate before{p.get_previous_position()};
+    assert(std::abs(before.get_x() - 1.0) < 0.000001);
+    assert(std::abs(before.get_y() - 2.0) < 0.000001);
+  }
+  // A placed projectile was not somewhere else before
+  {
+    projectile p{coordinate{1.0, 2.0}, 0.7};
+    p.move();
+    p.increment_age();
+    p.place(coordinate(10.0, 20.0));
+    assert(coordinate(10.0, 20.0) == p.get_previous_position());
+  }
+  // A new projectile has age zero
+  {
+    projectile p{coordinate{0.0, 0.0}};
+    assert(p.get_age() == 0);
+    p.increment_age();
+    assert(p.get_age() == 1);
+  }
   #endif
 
 #define FIX_ISSUE_327
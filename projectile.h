@@ -3,7 +3,6 @@
 #include "projectile_type.h"
 #include "coordinate.h"
 #include "color.h"
-#include <string>
 
 /// A projectile has the virtual shape of a circle
 class projectile
@@ -11,7 +10,7 @@ class projectile
 public:
   projectile(const coordinate c,
              const double direction = 0.0, projectile_type = projectile_type::rocket,
-             const double radius = 100, const std::string& owner_id = "-1");
+             const double radius = 100, const int owner_id = -1);
 
   coordinate get_position() const noexcept { return m_coordinate; }
   double get_x() const noexcept { return m_coordinate.get_x(); }
@@ -24,10 +23,21 @@ public:
   double get_radius() const noexcept {return m_radius;}
 
   /// Move a certain distance (of 1.0 for now) in the direction the projectile
-  /// is facing
-  void move();
-
-  ///Places a projectile at a given coordinate
+  /// is facing. Defined here, so that projectile_pool::move is one
+  /// loop without calls
+  void move() noexcept
+  {
+    m_previous_coordinate = m_coordinate;
+    m_coordinate.set_x(m_coordinate.get_x() + m_heading_x);
+    m_coordinate.set_y(m_coordinate.get_y() + m_heading_y);
+  }
+
+  /// Get the position before the latest move, which is the
+  /// current position if the projectile did not move
+  /// since it was created or placed
+  coordinate get_previous_position() const noexcept { return m_previous_coordinate; }
+
+  ///Places a projectile at a given coordinate, without a move
   void place(const coordinate& c);
 
   /// Get projectile type of the game
@@ -35,15 +45,33 @@ public:
 
   void set_type(const projectile_type &p_type) noexcept { m_projectile_type = p_type; }
 
-  std::string get_owner_id() noexcept;
+  /// Get the ID of the player that shot the projectile,
+  /// which is -1 if no player shot it
+  int get_owner_id() const noexcept { return m_owner_id; }
+
+  /// Get the number of ticks the projectile exists
+  int get_age() const noexcept { return m_age; }
+
+  /// Make the projectile one tick older
+  void increment_age() noexcept { ++m_age; }
+
+  /// Set the number of ticks the projectile exists
+  void set_age(const int age) noexcept { m_age = age; }
 
 private:
   /// The coordinate
   coordinate m_coordinate;
 
+  /// The coordinate before the latest move
+  coordinate m_previous_coordinate;
+
   /// The direction of projectile in radians
   double m_direction;
 
+  /// The unit vector in the direction of the projectile
+  double m_heading_x;
+  double m_heading_y;
+
   /// the environment
   projectile_type m_projectile_type;
 
@@ -51,7 +79,10 @@ private:
   double m_radius;
 
   /// The owner of the projectile
-  std::string m_owner_id;
+  int m_owner_id;
+
+  /// The number of ticks the projectile exists
+  int m_age = 0;
 
 };
 
@@ -0,0 +1,27 @@
+#include "projectile_hit.h"
+#include <cassert>
+
+projectile_hit::projectile_hit(const projectile& p, const int projectile_index, const int player_index)
+  : m_projectile{p}, m_projectile_index{projectile_index}, m_player_index{player_index}
+{
+  assert(m_projectile_index >= 0);
+  assert(m_player_index >= 0);
+}
+
+void test_projectile_hit()
+{
+  #ifndef NDEBUG // no tests in release
+  // Constructor
+  {
+    const coordinate c{1.2, 3.4};
+    const projectile p(c, 0.0, projectile_type::stun_rocket);
+    const int projectile_index{3};
+    const int player_index{5};
+    const projectile_hit h(p, projectile_index, player_index);
+    assert(h.get_projectile().get_position() == c);
+    assert(h.get_projectile().get_type() == projectile_type::stun_rocket);
+    assert(h.get_projectile_index() == projectile_index);
+    assert(h.get_player_index() == player_index);
+  }
+  #endif
+}
@@ -0,0 +1,36 @@
+#ifndef PROJECTILE_HIT_H
+#define PROJECTILE_HIT_H
+
+#include "projectile.h"
+
+/// A projectile that hit a player. The game collects these
+/// each tick, so that the rest of the game can react to them
+class projectile_hit
+{
+public:
+  projectile_hit(const projectile& p, const int projectile_index, const int player_index);
+
+  /// Get the projectile as it was when it hit the player
+  const projectile& get_projectile() const noexcept { return m_projectile; }
+
+  /// Get the index the projectile had in the game,
+  /// before the projectiles that hit a player were removed
+  int get_projectile_index() const noexcept { return m_projectile_index; }
+
+  /// Get the index of the player that was hit
+  int get_player_index() const noexcept { return m_player_index; }
+
+private:
+  /// The projectile that hit the player
+  projectile m_projectile;
+
+  /// The index the projectile had in the game
+  int m_projectile_index;
+
+  /// The index of the player that was hit
+  int m_player_index;
+};
+
+void test_projectile_hit();
+
+#endif // PROJECTILE_HIT_H
@@ -0,0 +1,110 @@
+#include "projectile_pool.h"
+
+#include <cassert>
+
+projectile_pool::projectile_pool(const std::size_t max_n_projectiles):
+  m_max_size{max_n_projectiles}
+{
+}
+
+bool projectile_pool::add(const projectile& p)
+{
+  if (is_full()) return false;
+  // Reserve once for all projectiles, so adding never reallocates after this
+  if (m_projectiles.capacity() < m_max_size) m_projectiles.reserve(m_max_size);
+  m_projectiles.push_back(p);
+  return true;
+}
+
+void projectile_pool::move() noexcept
+{
+  for (auto& p : m_projectiles)
+    {
+      p.move();
+      p.increment_age();
+    }
+}
+
+void projectile_pool::place(const int i, const coordinate& c)
+{
+  assert(i >= 0);
+  assert(i < static_cast<int>(m_projectiles.size()));
+  m_projectiles[i].place(c);
+}
+
+void test_projectile_pool() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A new pool is empty and has not reserved any room
+  {
+    const projectile_pool pool(3);
+    assert(pool.size() == 0);
+    assert(pool.get_max_size() == 3);
+    assert(pool.get().capacity() == 0);
+  }
+  // The first projectile reserves room for all, so adding does not reallocate
+  {
+    projectile_pool pool(3);
+    assert(pool.add(projectile(coordinate(1.0, 2.0))));
+    assert(pool.get().capacity() >= 3);
+    const projectile * const data{pool.get().data()};
+    assert(pool.add(projectile(coordinate(3.0, 4.0))));
+    assert(pool.add(projectile(coordinate(5.0, 6.0))));
+    assert(pool.get().data() == data);
+    assert(pool.size() == 3);
+  }
+  // A full pool does not add a projectile
+  {
+    projectile_pool pool(1);
+    assert(pool.add(projectile(coordinate(1.0, 2.0))));
+    assert(pool.is_full());
+    assert(!pool.add(projectile(coordinate(3.0, 4.0))));
+    assert(pool.size() == 1);
+  }
+  // All projectiles move and get older
+  {
+    projectile_pool pool;
+    pool.add(projectile(coordinate(1.0, 2.0), 0.0));
+    pool.move();
+    assert(get_x(pool.get()[0]) == 2.0);
+    assert(pool.get()[0].get_age() == 1);
+  }
+  // A projectile can be placed
+  {
+    projectile_pool pool;
+    pool.add(projectile(coordinate(1.0, 2.0)));
+    pool.place(0, coordinate(3.0, 4.0));
+    assert(pool.get()[0].get_position() == coordinate(3.0, 4.0));
+  }
+  // Culling puts the last projectile in the place of a removed one
+  {
+    projectile_pool pool;
+    for (int i = 0; i != 4; ++i) pool.add(projectile(coordinate(i, 0.0)));
+    pool.cull([](const projectile& p) { return get_x(p) == 1.0; });
+    assert(pool.size() == 3);
+    assert(get_x(pool.get()[0]) == 0.0);
+    assert(get_x(pool.get()[1]) == 3.0);
+    assert(get_x(pool.get()[2]) == 2.0);
+  }
+  // Removing by index keeps the order of the other projectiles
+  {
+    projectile_pool pool;
+    for (int i = 0; i != 4; ++i) pool.add(projectile(coordinate(i, 0.0)));
+    pool.remove_if([](const int i) { return i == 0 || i == 2; });
+    assert(pool.size() == 2);
+    assert(get_x(pool.get()[0]) == 1.0);
+    assert(get_x(pool.get()[1]) == 3.0);
+  }
+  // A copy has the same projectiles and reserves room for all when it adds one
+  {
+    projectile_pool pool(3);
+    pool.add(projectile(coordinate(1.0, 2.0)));
+    projectile_pool copy{pool};
+    assert(copy.size() == 1);
+    assert(copy.get_max_size() == 3);
+    assert(copy.add(projectile(coordinate(3.0, 4.0))));
+    assert(copy.get().capacity() >= 3);
+    assert(pool.size() == 1);
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,100 @@
+#ifndef PROJECTILE_POOL_H
+#define PROJECTILE_POOL_H
+
+#include "projectile.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// The projectiles of a game, at most a maximum number of these.
+/// Room for the maximum number is reserved when the first projectile
+/// is added, after which adding and removing never allocate.
+/// A copy only has room for the projectiles it has, until it adds one,
+/// so that copying a game does not reserve room it may never use
+class projectile_pool
+{
+public:
+  explicit projectile_pool(const std::size_t max_n_projectiles = 1000);
+
+  /// Add a projectile, unless the pool is full.
+  /// Returns true if the projectile is added
+  bool add(const projectile& p);
+
+  /// Move all projectiles and make them one tick older
+  void move() noexcept;
+
+  /// Place the i-th projectile at a coordinate
+  void place(const int i, const coordinate& c);
+
+  /// Remove the projectiles for which 'is_gone(projectile)' is true.
+  /// The last projectile takes the place of a removed one,
+  /// so the order of the projectiles changes
+  template <typename Predicate>
+  void cull(Predicate is_gone);
+
+  /// Remove the projectiles for which 'is_gone(index)' is true,
+  /// keeping the order of the other projectiles.
+  /// 'is_gone' is called once per projectile, in increasing order of index
+  template <typename Predicate>
+  void remove_if(Predicate is_gone);
+
+  /// Remove all projectiles
+  void clear() noexcept { m_projectiles.clear(); }
+
+  /// Get the projectiles
+  const std::vector<projectile>& get() const noexcept { return m_projectiles; }
+
+  /// The number of projectiles
+  std::size_t size() const noexcept { return m_projectiles.size(); }
+
+  /// Can no projectile be added?
+  bool is_full() const noexcept { return m_projectiles.size() >= m_max_size; }
+
+  /// The maximum number of projectiles
+  std::size_t get_max_size() const noexcept { return m_max_size; }
+
+private:
+  std::vector<projectile> m_projectiles;
+  std::size_t m_max_size;
+};
+
+template <typename Predicate>
+void projectile_pool::cull(Predicate is_gone)
+{
+  std::size_t i = 0;
+  while (i != m_projectiles.size())
+    {
+      if (is_gone(static_cast<const projectile&>(m_projectiles[i])))
+        {
+          // Swap and pop, i is now the index of the last projectile
+          if (i + 1 != m_projectiles.size())
+            {
+              m_projectiles[i] = std::move(m_projectiles.back());
+            }
+          m_projectiles.pop_back();
+        }
+      else
+        {
+          ++i;
+        }
+    }
+}
+
+template <typename Predicate>
+void projectile_pool::remove_if(Predicate is_gone)
+{
+  const int n{static_cast<int>(m_projectiles.size())};
+  int n_kept{0};
+  for (int i = 0; i != n; ++i)
+    {
+      if (is_gone(i)) continue;
+      if (n_kept != i) m_projectiles[n_kept] = std::move(m_projectiles[i]);
+      ++n_kept;
+    }
+  m_projectiles.erase(std::begin(m_projectiles) + n_kept, std::end(m_projectiles));
+}
+
+/// Test the projectile_pool class
+void test_projectile_pool();
+
+#endif // PROJECTILE_POOL_H
@@ -0,0 +1,189 @@
+#include "render_snapshot.h"
+
+#include "fixed_timestep.h"
+#include "game.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void remember_state(const game& g, previous_state& s)
+{
+  s.m_player_positions.clear();
+  s.m_player_directions.clear();
+  for (const auto& p : g.get_v_player())
+    {
+      s.m_player_positions.push_back(p.get_position());
+      s.m_player_directions.push_back(p.get_direction());
+    }
+  s.m_shelter_positions.clear();
+  for (const auto& sh : g.get_shelters())
+    {
+      s.m_shelter_positions.push_back(sh.get_position());
+    }
+}
+
+coordinate get_drawn_position(const player_snapshot& p, const double alpha) noexcept
+{
+  if (alpha >= 1.0) return p.m_position;
+  return interpolate(p.m_previous_position, p.m_position, alpha);
+}
+
+double get_drawn_direction(const player_snapshot& p, const double alpha) noexcept
+{
+  if (alpha >= 1.0) return p.m_direction;
+  return interpolate_angle(p.m_previous_direction, p.m_direction, alpha);
+}
+
+coordinate get_drawn_position(const projectile_snapshot& p, const double alpha) noexcept
+{
+  if (alpha >= 1.0) return p.m_position;
+  return interpolate(p.m_previous_position, p.m_position, alpha);
+}
+
+coordinate get_drawn_position(const shelter_snapshot& s, const double alpha) noexcept
+{
+  if (alpha >= 1.0) return s.m_position;
+  return interpolate(s.m_previous_position, s.m_position, alpha);
+}
+
+double get_alpha(const render_snapshot& s,
+                 const double tick_duration,
+                 const std::chrono::steady_clock::time_point& now) noexcept
+{
+  const double seconds{std::chrono::duration<double>(now - s.m_taken_at).count()};
+  return std::min(1.0, std::max(0.0, seconds / tick_duration));
+}
+
+void take_snapshot(const game& g,
+                   const previous_state& previous,
+                   render_snapshot& s)
+{
+  s.m_n_ticks = g.get_n_ticks();
+
+  // Resize instead of clear, so that the names keep their memory
+  const std::vector<player>& players = g.get_v_player();
+  s.m_players.resize(players.size());
+  for (std::size_t i = 0; i != players.size(); ++i)
+    {
+      const player& p = players[i];
+      player_snapshot& ps = s.m_players[i];
+      ps.m_position = p.get_position();
+      ps.m_direction = p.get_direction();
+      const bool is_known{i < previous.m_player_positions.size()};
+      ps.m_previous_position = is_known ? previous.m_player_positions[i] : ps.m_position;
+      ps.m_previous_direction = is_known ? previous.m_player_directions[i] : ps.m_direction;
+      ps.m_diameter = p.get_diameter();
+      ps.m_color = p.get_color();
+      ps.m_shape = p.get_shape();
+      ps.m_is_dead = is_dead(p);
+      ps.m_name = g.get_player_name(p.get_ID());
+    }
+
+  const std::vector<food>& food = g.get_food();
+  s.m_has_food = !food.empty() && !food[0].is_eaten();
+  if (!food.empty()) s.m_food_position = food[0].get_position();
+
+  s.m_projectiles.clear();
+  for (const auto& p : g.get_projectiles())
+    {
+      projectile_snapshot ps;
+      ps.m_previous_position = p.get_previous_position();
+      ps.m_position = p.get_position();
+      ps.m_direction = p.get_direction();
+      ps.m_type = p.get_type();
+      s.m_projectiles.push_back(ps);
+    }
+
+  s.m_shelters.clear();
+  const std::vector<shelter>& shelters = g.get_shelters();
+  for (std::size_t i = 0; i != shelters.size(); ++i)
+    {
+      const shelter& sh = shelters[i];
+      shelter_snapshot ss;
+      ss.m_position = sh.get_position();
+      ss.m_previous_position = i < previous.m_shelter_positions.size()
+        ? previous.m_shelter_positions[i] : ss.m_position;
+      ss.m_radius = sh.get_radius();
+      ss.m_color = sh.get_color();
+      s.m_shelters.push_back(ss);
+    }
+}
+
+void test_render_snapshot() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A snapshot has what is needed to draw the game
+  {
+    game g;
+    add_projectile(g, projectile(coordinate(100.0, 200.0), 1.0, projectile_type::stun_rocket));
+    render_snapshot s;
+    take_snapshot(g, {}, s);
+    assert(s.m_n_ticks == 0);
+    assert(s.m_players.size() == g.get_v_player().size());
+    for (std::size_t i = 0; i != s.m_players.size(); ++i)
+      {
+        const player& p = g.get_v_player()[i];
+        const player_snapshot& ps = s.m_players[i];
+        assert(p.get_position() == ps.m_position);
+        assert(p.get_position() == ps.m_previous_position);
+        assert(ps.m_diameter == p.get_diameter());
+        assert(ps.m_shape == p.get_shape());
+        assert(ps.m_name == g.get_player_name(p.get_ID()));
+      }
+    assert(s.m_projectiles.size() == 1);
+    assert(coordinate(100.0, 200.0) == s.m_projectiles[0].m_position);
+    assert(s.m_projectiles[0].m_type == projectile_type::stun_rocket);
+    assert(s.m_shelters.size() == g.get_shelters().size());
+    assert(s.m_has_food == !g.get_food()[0].is_eaten());
+  }
+  // A snapshot knows where the things were before the latest tick,
+  // to draw these in between ticks
+  {
+    game g;
+    add_projectile(g, projectile(coordinate(100.0, 200.0), 0.0));
+    previous_state previous;
+    remember_state(g, previous);
+    g.get_player(0).accelerate();
+    g.tick();
+    render_snapshot s;
+    take_snapshot(g, previous, s);
+    assert(s.m_n_ticks == 1);
+    coordinate before{previous.m_player_positions[0]};
+    const player_snapshot& p = s.m_players[0];
+    assert(before == p.m_previous_position);
+    assert(before != p.m_position);
+    assert(p.m_previous_direction == previous.m_player_directions[0]);
+    assert(get_drawn_position(p, 0.0) == before);
+    assert(get_drawn_position(p, 1.0) == p.m_position);
+    assert(get_drawn_position(p, 0.5) == interpolate(before, p.m_position, 0.5));
+    assert(get_drawn_direction(p, 1.0) == p.m_direction);
+    // Projectiles move one unit per tick
+    const projectile_snapshot& pr = s.m_projectiles[0];
+    assert(std::abs(get_drawn_position(pr, 0.5).get_x() - 100.5) < 0.000001);
+    // Shelters drift
+    const shelter_snapshot& sh = s.m_shelters[0];
+    assert(previous.m_shelter_positions[0] == sh.m_previous_position);
+    assert(get_drawn_position(sh, 0.0) == previous.m_shelter_positions[0]);
+  }
+  // A snapshot taken on another thread is drawn from its previous state
+  // to its current state during the tick after it was taken
+  {
+    render_snapshot s;
+    s.m_taken_at = std::chrono::steady_clock::now();
+    const double tick_duration{0.1};
+    assert(get_alpha(s, tick_duration, s.m_taken_at) == 0.0);
+    assert(std::abs(get_alpha(s, tick_duration, s.m_taken_at + std::chrono::milliseconds(50)) - 0.5) < 0.000001);
+    assert(get_alpha(s, tick_duration, s.m_taken_at + std::chrono::seconds(1)) == 1.0);
+  }
+  // Taking a snapshot again replaces the earlier one
+  {
+    game g;
+    add_projectile(g, projectile(coordinate(100.0, 200.0)));
+    render_snapshot s;
+    take_snapshot(g, {}, s);
+    take_snapshot(game(), {}, s);
+    assert(s.m_projectiles.empty());
+  }
+#endif // no tests in release
+}
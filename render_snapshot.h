@@ -0,0 +1,121 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "color.h"
+#include "coordinate.h"
+#include "player_shape.h"
+#include "projectile_type.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+class game;
+
+/// Where the things of a game were before its latest tick,
+/// so that a frame can be drawn in between two ticks.
+/// The projectiles are not here, as these know where they were
+struct previous_state
+{
+  std::vector<coordinate> m_player_positions;
+  std::vector<double> m_player_directions;
+  std::vector<coordinate> m_shelter_positions;
+};
+
+/// Remember where the things of a game are, before a tick,
+/// reusing the memory of the previous state
+void remember_state(const game& g, previous_state& s);
+
+/// What is needed to draw a player
+struct player_snapshot
+{
+  /// The position before the latest tick
+  coordinate m_previous_position{0.0, 0.0};
+  coordinate m_position{0.0, 0.0};
+
+  /// The direction before the latest tick
+  double m_previous_direction = 0.0;
+  double m_direction = 0.0;
+  double m_diameter = 0.0;
+  color m_color;
+  player_shape m_shape = player_shape::rocket;
+  bool m_is_dead = false;
+  std::string m_name;
+};
+
+/// What is needed to draw a projectile
+struct projectile_snapshot
+{
+  /// The position before the latest tick
+  coordinate m_previous_position{0.0, 0.0};
+  coordinate m_position{0.0, 0.0};
+  double m_direction = 0.0;
+  projectile_type m_type = projectile_type::rocket;
+};
+
+/// What is needed to draw a shelter
+struct shelter_snapshot
+{
+  /// The position before the latest tick
+  coordinate m_previous_position{0.0, 0.0};
+  coordinate m_position{0.0, 0.0};
+  double m_radius = 0.0;
+  color m_color;
+};
+
+/// What is needed to draw a game at one tick. The simulation
+/// writes it, after which it is never changed, so that it can
+/// be drawn on another thread while the simulation goes on
+struct render_snapshot
+{
+  /// The number of ticks done when the snapshot was taken
+  int m_n_ticks = 0;
+
+  /// When the snapshot was taken, if it was taken on another thread
+  std::chrono::steady_clock::time_point m_taken_at;
+
+  std::vector<player_snapshot> m_players;
+
+  /// The position of the first food item, the only one drawn
+  coordinate m_food_position{0.0, 0.0};
+
+  /// Is there a first food item that is not eaten?
+  bool m_has_food = false;
+
+  std::vector<projectile_snapshot> m_projectiles;
+  std::vector<shelter_snapshot> m_shelters;
+};
+
+/// Get the position a player is drawn at, which is between its
+/// positions before and after the latest tick.
+/// 'alpha' is zero at the position before and one at the position after it
+coordinate get_drawn_position(const player_snapshot& p, const double alpha) noexcept;
+
+/// Get the direction a player is drawn in, which is between its
+/// directions before and after the latest tick
+double get_drawn_direction(const player_snapshot& p, const double alpha) noexcept;
+
+/// Get the position a projectile is drawn at, which is between its
+/// positions before and after the latest tick
+coordinate get_drawn_position(const projectile_snapshot& p, const double alpha) noexcept;
+
+/// Get the position a shelter is drawn at, which is between its
+/// positions before and after the latest tick
+coordinate get_drawn_position(const shelter_snapshot& s, const double alpha) noexcept;
+
+/// Get how far the time is from the latest tick of a snapshot,
+/// taken on another thread, towards the next tick, from zero to one
+double get_alpha(const render_snapshot& s,
+                 const double tick_duration,
+                 const std::chrono::steady_clock::time_point& now) noexcept;
+
+/// Take a snapshot of a game, reusing the memory of the snapshot.
+/// @param previous where the things were before the latest tick,
+///   for the things that are not in it, these are where they are now
+void take_snapshot(const game& g,
+                   const previous_state& previous,
+                   render_snapshot& s);
+
+/// Test the render snapshot
+void test_render_snapshot();
+
+#endif // RENDER_SNAPSHOT_H
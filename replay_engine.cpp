@@ -0,0 +1,127 @@
+#include "replay_engine.h"
+#include "state_hash.h"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+replay_engine::replay_engine(const action_log& log, const bool check_state_hashes):
+  m_log{log},
+  m_check_state_hashes{check_state_hashes && log.has_state_hashes()},
+  m_game{create_game(log)},
+  m_reader(log),
+  m_n_ticks{0},
+  m_first_divergent_tick{-1},
+  m_duration{0.0}
+{
+}
+
+bool replay_engine::tick()
+{
+  if (m_n_ticks == m_log.get_n_ticks()) return false;
+  m_reader.apply_next_tick(m_game);
+  m_game.tick();
+  if (m_check_state_hashes
+      && m_first_divergent_tick == -1
+      && calc_state_hash(m_game) != m_log.get_state_hashes()[m_n_ticks])
+    {
+      m_first_divergent_tick = m_n_ticks;
+    }
+  ++m_n_ticks;
+  return true;
+}
+
+void replay_engine::run()
+{
+  const auto start = std::chrono::steady_clock::now();
+  while (tick()) {}
+  const auto end = std::chrono::steady_clock::now();
+  m_duration += std::chrono::duration<double>(end - start).count();
+}
+
+double replay_engine::get_ticks_per_second() const noexcept
+{
+  if (m_duration <= 0.0) return 0.0;
+  return static_cast<double>(m_n_ticks) / m_duration;
+}
+
+void write_replay_report(std::ostream& os, const replay_engine& r)
+{
+  os << "ticks: " << r.get_n_ticks() << '\n'
+     << "ticks/second: " << r.get_ticks_per_second() << '\n';
+  if (r.has_diverged())
+    {
+      os << "diverged after tick: " << r.get_first_divergent_tick() << '\n';
+    }
+  else
+    {
+      os << "no divergence\n";
+    }
+}
+
+void test_replay_engine() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A replay ends in the same state as the logged game
+  {
+    game g(environment(), 3, 0, 42, 1, 1, 7);
+    action_log log(g.get_env(), 3, 42, 1, 1, 7);
+    for (int tick = 0; tick != 300; ++tick)
+      {
+        player& p = g.get_player(tick % 3);
+        if (tick % 20 == 0) p.get_action_set().clear();
+        if (tick % 30 == 0) p.get_action_set().insert(action_type::accelerate);
+        if (tick % 50 == 0) p.get_action_set().insert(action_type::turn_left);
+        if (tick % 70 == 0) p.get_action_set().insert(action_type::shoot);
+        record_tick(g, log);
+      }
+    replay_engine r(log);
+    r.run();
+    assert(r.get_n_ticks() == 300);
+    assert(!r.has_diverged());
+    assert(calc_state_hash(r.get_game()) == calc_state_hash(g));
+    assert(!r.tick());
+  }
+  // A replay that differs from the log shows where it diverged
+  {
+    game g;
+    action_log log;
+    for (int tick = 0; tick != 10; ++tick)
+      {
+        if (tick == 4) g.get_player(0).get_action_set().insert(action_type::accelerate);
+        record_tick(g, log);
+      }
+    // The same state hashes, yet player 0 never accelerates
+    const game h;
+    action_log bad_log;
+    for (int tick = 0; tick != 10; ++tick)
+      {
+        bad_log.add_actions(h);
+        bad_log.add_state_hash(log.get_state_hashes()[tick]);
+      }
+    replay_engine r(bad_log);
+    r.run();
+    assert(r.get_first_divergent_tick() == 4);
+  }
+  // Without checking, a replay never diverges
+  {
+    action_log log;
+    game h;
+    log.add_actions(h);
+    log.add_state_hash(0);
+    replay_engine r(log, false);
+    r.run();
+    assert(!r.has_diverged());
+  }
+  // A report can be written
+  {
+    const action_log log;
+    replay_engine r(log);
+    r.run();
+    std::stringstream s;
+    write_replay_report(s, r);
+    assert(!s.str().empty());
+  }
+#endif // no tests in release
+}
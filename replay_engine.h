@@ -0,0 +1,61 @@
+#ifndef REPLAY_ENGINE_H
+#define REPLAY_ENGINE_H
+
+#include "action_log.h"
+#include "game.h"
+#include <cstdint>
+#include <iosfwd>
+
+/// Replays an action log without a window, as fast as possible:
+/// it creates the game the log starts with and, each tick,
+/// gives the players their logged actions and ticks the game.
+/// If the log has state hashes, it finds the first tick
+/// after which the game differs from the logged game
+class replay_engine
+{
+public:
+  /// @param log the log to replay, must outlive the engine
+  /// @param check_state_hashes compare the state after each tick to the log,
+  ///   if the log has state hashes
+  explicit replay_engine(const action_log& log, const bool check_state_hashes = true);
+
+  /// Replay the next tick, returns false if all ticks are replayed
+  bool tick();
+
+  /// Replay all ticks that are left
+  void run();
+
+  /// The replayed game
+  const game& get_game() const noexcept { return m_game; }
+
+  /// The number of ticks replayed
+  int get_n_ticks() const noexcept { return m_n_ticks; }
+
+  /// The index of the first tick after which the state differs
+  /// from the log, -1 if there is no such tick (yet)
+  int get_first_divergent_tick() const noexcept { return m_first_divergent_tick; }
+
+  bool has_diverged() const noexcept { return m_first_divergent_tick != -1; }
+
+  /// The number of ticks replayed per second
+  double get_ticks_per_second() const noexcept;
+
+private:
+  const action_log& m_log;
+  const bool m_check_state_hashes;
+  game m_game;
+  action_log_reader m_reader;
+  int m_n_ticks;
+  int m_first_divergent_tick;
+
+  /// The time spent replaying, in seconds
+  double m_duration;
+};
+
+/// Write the outcome of a replay
+void write_replay_report(std::ostream& os, const replay_engine& r);
+
+/// Test the replay engine
+void test_replay_engine();
+
+#endif // REPLAY_ENGINE_H
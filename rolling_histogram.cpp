@@ -0,0 +1,144 @@
+#include "rolling_histogram.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+rolling_histogram::rolling_histogram(const int window_size):
+  m_window(static_cast<std::size_t>(std::max(window_size, 0)), 0),
+  m_next{0},
+  m_n{0},
+  m_n_added{0},
+  m_sum{0},
+  m_bucket_counts(static_cast<std::size_t>(get_n_buckets()), 0)
+{
+  if (window_size < 1)
+    {
+      throw std::invalid_argument("A rolling histogram needs a window of at least one duration");
+    }
+}
+
+void rolling_histogram::add(const std::int64_t ns) noexcept
+{
+  const std::int64_t duration{std::max(ns, std::int64_t(0))};
+  if (m_n == get_window_size())
+    {
+      const std::int64_t oldest{m_window[m_next]};
+      --m_bucket_counts[get_bucket(oldest)];
+      m_sum -= oldest;
+    }
+  else
+    {
+      ++m_n;
+    }
+  m_window[m_next] = duration;
+  ++m_bucket_counts[get_bucket(duration)];
+  m_sum += duration;
+  ++m_n_added;
+  m_next = (m_next + 1) % get_window_size();
+}
+
+double rolling_histogram::get_mean() const noexcept
+{
+  if (m_n == 0) return 0.0;
+  return static_cast<double>(m_sum) / static_cast<double>(m_n);
+}
+
+std::int64_t rolling_histogram::get_max() const noexcept
+{
+  // The durations that are not in the window yet are zero
+  return *std::max_element(std::begin(m_window), std::end(m_window));
+}
+
+std::int64_t rolling_histogram::get_percentile(const double p) const noexcept
+{
+  assert(p >= 0.0);
+  assert(p <= 100.0);
+  if (m_n == 0) return 0;
+  const double rank{std::max(1.0, std::ceil(p / 100.0 * static_cast<double>(m_n)))};
+  int n_seen{0};
+  for (int bucket = 0; bucket != get_n_buckets(); ++bucket)
+    {
+      n_seen += m_bucket_counts[bucket];
+      if (n_seen >= rank) return get_bucket_upper_bound(bucket);
+    }
+  return get_bucket_upper_bound(get_n_buckets() - 1);
+}
+
+int rolling_histogram::get_bucket(const std::int64_t ns) noexcept
+{
+  int bucket{0};
+  for (std::uint64_t x = static_cast<std::uint64_t>(std::max(ns, std::int64_t(0))); x != 0; x >>= 1)
+    {
+      ++bucket;
+    }
+  return std::min(bucket, get_n_buckets() - 1);
+}
+
+std::int64_t rolling_histogram::get_bucket_upper_bound(const int bucket) noexcept
+{
+  assert(bucket >= 0);
+  assert(bucket < get_n_buckets());
+  if (bucket == get_n_buckets() - 1) return INT64_MAX;
+  return (std::int64_t(1) << bucket) - 1;
+}
+
+void test_rolling_histogram() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A new histogram is empty
+  {
+    const rolling_histogram h;
+    assert(h.get_n() == 0);
+    assert(h.get_mean() == 0.0);
+    assert(h.get_max() == 0);
+    assert(h.get_percentile(50.0) == 0);
+  }
+  // Durations go to the bucket of their highest bit
+  {
+    assert(rolling_histogram::get_bucket(0) == 0);
+    assert(rolling_histogram::get_bucket(1) == 1);
+    assert(rolling_histogram::get_bucket(2) == 2);
+    assert(rolling_histogram::get_bucket(3) == 2);
+    assert(rolling_histogram::get_bucket(4) == 3);
+    assert(rolling_histogram::get_bucket(1000) == 10);
+    assert(rolling_histogram::get_bucket(-5) == 0);
+    for (const std::int64_t ns : {0, 1, 3, 1000, 123456789})
+      {
+        assert(ns <= rolling_histogram::get_bucket_upper_bound(rolling_histogram::get_bucket(ns)));
+      }
+  }
+  // The mean, maximum and percentiles are those of the window
+  {
+    rolling_histogram h(4);
+    h.add(1000000);
+    h.add(10);
+    h.add(20);
+    h.add(30);
+    h.add(40);
+    assert(h.get_n() == 4);
+    assert(h.get_n_added() == 5);
+    assert(h.get_mean() == 25.0);
+    assert(h.get_max() == 40);
+    assert(h.get_percentile(25.0) == 15);
+    assert(h.get_percentile(100.0) == 63);
+    int n_counted{0};
+    for (const int n : h.get_bucket_counts()) n_counted += n;
+    assert(n_counted == 4);
+  }
+  // A window must have room for a duration
+  {
+    bool has_thrown{false};
+    try
+    {
+      rolling_histogram h(0);
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,64 @@
+#ifndef ROLLING_HISTOGRAM_H
+#define ROLLING_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+/// A histogram of the latest durations, in nanoseconds.
+/// Bucket b has the durations from 2^(b-1) up to 2^b,
+/// bucket zero has the durations of zero.
+/// When the window is full, adding a duration removes the oldest one.
+/// Adding never allocates
+class rolling_histogram
+{
+public:
+  /// @param window_size the number of latest durations kept
+  explicit rolling_histogram(const int window_size = 1024);
+
+  /// Add a duration, negative durations count as zero
+  void add(const std::int64_t ns) noexcept;
+
+  /// The number of durations in the window
+  int get_n() const noexcept { return m_n; }
+
+  /// The number of durations ever added
+  std::int64_t get_n_added() const noexcept { return m_n_added; }
+
+  int get_window_size() const noexcept { return static_cast<int>(m_window.size()); }
+
+  /// The mean of the durations in the window, zero if it is empty
+  double get_mean() const noexcept;
+
+  /// The longest duration in the window, zero if it is empty
+  std::int64_t get_max() const noexcept;
+
+  /// The upper bound of the bucket that has the p-th
+  /// percentile (p in [0, 100]) of the durations in the window,
+  /// zero if it is empty
+  std::int64_t get_percentile(const double p) const noexcept;
+
+  /// The number of durations in the window per bucket
+  const std::vector<int>& get_bucket_counts() const noexcept { return m_bucket_counts; }
+
+  /// Get the bucket of a duration
+  static int get_bucket(const std::int64_t ns) noexcept;
+
+  /// Get the upper bound of a bucket, in nanoseconds
+  static std::int64_t get_bucket_upper_bound(const int bucket) noexcept;
+
+  static int get_n_buckets() noexcept { return 64; }
+
+private:
+  /// The latest durations, m_next is the oldest when the window is full
+  std::vector<std::int64_t> m_window;
+  int m_next;
+  int m_n;
+  std::int64_t m_n_added;
+  std::int64_t m_sum;
+  std::vector<int> m_bucket_counts;
+};
+
+/// Test the rolling_histogram class
+void test_rolling_histogram();
+
+#endif // ROLLING_HISTOGRAM_H
@@ -36,10 +36,11 @@ double shelter::get_y() const noexcept
   return m_c.get_y();
 }
 
-void shelter::make_shelter_drift()
+void shelter::make_shelter_drift(fast_rng& rng)
 {
-  double new_x = m_c.get_x() + std::cos(rand());
-  double new_y = m_c.get_y() + std::sin(rand());
+  const double angle{rng.uniform(0.0, 2.0 * M_PI)};
+  double new_x = m_c.get_x() + std::cos(angle);
+  double new_y = m_c.get_y() + std::sin(angle);
   m_c = coordinate(new_x, new_y);
 }
 
@@ -106,12 +107,25 @@ void test_shelter() //!OCLINT tests may be complex
   //test that shelter moves with each tick
   {
     shelter f;
+    fast_rng rng;
     assert(get_x(f) == 0.0);
     assert(get_y(f) == 0.0);
-    f.make_shelter_drift();
-    f.make_shelter_drift(); //move shelter
+    f.make_shelter_drift(rng);
+    f.make_shelter_drift(rng); //move shelter
     assert(get_x(f) != 0.0); //see that shelter moves
   }
+  //shelters with the same random numbers drift the same way
+  {
+    shelter a;
+    shelter b;
+    fast_rng rng_a(42);
+    fast_rng rng_b(42);
+    a.make_shelter_drift(rng_a);
+    b.make_shelter_drift(rng_b);
+    assert(get_x(a) == get_x(b));
+    assert(get_y(a) == get_y(b));
+    assert(std::abs(std::hypot(get_x(a), get_y(a)) - 1.0) < 0.000001);
+  }
   // Colors
   {
     const int r{1};
@@ -3,6 +3,7 @@
 
 #include "color.h"
 #include "coordinate.h"
+#include "fast_rng.h"
 #include <cmath>
 #include "string.h"
 class shelter
@@ -21,8 +22,8 @@ public:
   double get_y() const noexcept;
   double get_speed() const noexcept;
   double get_direction() const noexcept;
-  // Make shelter drift in a random direction
-  void make_shelter_drift();
+  // Make shelter drift one unit in a random direction
+  void make_shelter_drift(fast_rng& rng);
 
 private:
   color m_color;
@@ -0,0 +1,173 @@
+#include "simulation_thread.h"
+
+#include <cassert>
+#include <chrono>
+
+simulation_thread::simulation_thread(game& g, action_log& log, const fixed_timestep& timestep):
+  m_game{g},
+  m_log{log},
+  m_timestep{timestep},
+  m_actions(g.get_v_player().size()),
+  m_n_ticks{g.get_n_ticks()},
+  m_must_stop{false},
+  m_ticking_thread_id{std::thread::id()}
+{
+  const int n_players{static_cast<int>(g.get_v_player().size())};
+  for (int i = 0; i != n_players; ++i)
+    {
+      m_actions[i].store(g.get_player(i).get_action_set().get_bits());
+    }
+  // The thread that draws has a snapshot before the first tick
+  take_snapshot(m_game, m_previous, m_snapshots.get_back());
+  m_snapshots.get_back().m_taken_at = std::chrono::steady_clock::now();
+  m_snapshots.publish();
+}
+
+simulation_thread::~simulation_thread()
+{
+  stop();
+}
+
+void simulation_thread::start()
+{
+  assert(!is_running());
+  m_must_stop.store(false);
+  m_thread = std::thread(&simulation_thread::run, this);
+}
+
+void simulation_thread::stop()
+{
+  if (!is_running()) return;
+  m_must_stop.store(true);
+  m_thread.join();
+  m_ticking_thread_id.store(std::thread::id());
+}
+
+bool simulation_thread::may_use_game() const noexcept
+{
+  const std::thread::id id{m_ticking_thread_id.load()};
+  return id == std::thread::id() || id == std::this_thread::get_id();
+}
+
+void simulation_thread::set_actions(const int i, const action_set& actions) noexcept
+{
+  assert(i >= 0 && i < static_cast<int>(m_actions.size()));
+  m_actions[i].store(actions.get_bits());
+}
+
+int simulation_thread::advance(const double seconds)
+{
+  // A game is not thread-safe, not even its const member functions
+  assert(may_use_game());
+  const int n_ticks{m_timestep.advance(seconds)};
+  for (int i = 0; i != n_ticks; ++i)
+    {
+      tick();
+    }
+  if (n_ticks > 0)
+    {
+      take_snapshot(m_game, m_previous, m_snapshots.get_back());
+      m_snapshots.get_back().m_taken_at = std::chrono::steady_clock::now();
+      m_snapshots.publish();
+    }
+  return n_ticks;
+}
+
+const render_snapshot& simulation_thread::get_newest_snapshot() noexcept
+{
+  m_snapshots.update();
+  return m_snapshots.get_front();
+}
+
+void simulation_thread::run()
+{
+  m_ticking_thread_id.store(std::this_thread::get_id());
+  using namespace std::chrono;
+  auto before = steady_clock::now();
+  while (!m_must_stop.load())
+    {
+      const auto now = steady_clock::now();
+      advance(duration<double>(now - before).count());
+      before = now;
+      // Sleep until the next tick is due
+      const double seconds_left{(1.0 - m_timestep.get_alpha()) * m_timestep.get_tick_duration()};
+      std::this_thread::sleep_for(duration<double>(seconds_left));
+    }
+}
+
+void simulation_thread::tick()
+{
+  const int n_players{static_cast<int>(m_actions.size())};
+  for (int i = 0; i != n_players; ++i)
+    {
+      m_game.get_player(i).get_action_set().set_bits(m_actions[i].load());
+    }
+  remember_state(m_game, m_previous);
+  record_tick(m_game, m_log);
+  ++m_n_ticks;
+}
+
+void test_simulation_thread() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // Before any tick, there is a snapshot of the game as it is
+  {
+    game g;
+    action_log log;
+    simulation_thread s(g, log, fixed_timestep(60.0));
+    assert(s.get_n_ticks() == 0);
+    assert(s.get_newest_snapshot().m_n_ticks == 0);
+    assert(s.get_newest_snapshot().m_players.size() == g.get_v_player().size());
+  }
+  // Advancing does the ticks that are due, logs these
+  // and publishes a snapshot
+  {
+    game g;
+    action_log log;
+    simulation_thread s(g, log, fixed_timestep(10.0));
+    assert(s.advance(0.05) == 0);
+    assert(s.advance(0.1) == 1);
+    assert(s.get_n_ticks() == 1);
+    assert(g.get_n_ticks() == 1);
+    assert(log.get_n_ticks() == 1);
+    assert(s.get_newest_snapshot().m_n_ticks == 1);
+  }
+  // The actions set are used by the next tick,
+  // the snapshot has the positions before and after the latest tick
+  {
+    game g;
+    action_log log;
+    simulation_thread s(g, log, fixed_timestep(10.0));
+    s.set_actions(0, action_set{action_type::accelerate});
+    s.advance(0.1);
+    assert(g.get_player(0).get_action_set().count(action_type::accelerate));
+    coordinate before{g.get_player(0).get_position()};
+    s.advance(0.1);
+    const player_snapshot& p = s.get_newest_snapshot().m_players[0];
+    assert(before == p.m_previous_position);
+    assert(g.get_player(0).get_position() == p.m_position);
+    assert(before != p.m_position);
+  }
+  // On its own thread, the game ticks until stopped,
+  // after which the game can be used again
+  {
+    game g;
+    action_log log;
+    simulation_thread s(g, log, fixed_timestep(1000.0));
+    s.start();
+    assert(s.is_running());
+    while (s.get_newest_snapshot().m_n_ticks < 3)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    s.stop();
+    assert(!s.is_running());
+    assert(g.get_n_ticks() >= 3);
+    assert(g.get_n_ticks() == s.get_n_ticks());
+    assert(log.get_n_ticks() == g.get_n_ticks());
+    // Once stopped, this thread may advance the game again
+    assert(s.advance(0.0) == 0);
+    s.stop();
+  }
+#endif // no tests in release
+}
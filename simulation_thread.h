@@ -0,0 +1,97 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include "action_log.h"
+#include "action_set.h"
+#include "fixed_timestep.h"
+#include "game.h"
+#include "render_snapshot.h"
+#include "triple_buffer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/// Ticks a game on a thread of its own, at a fixed tick rate,
+/// so that slow frames do not slow down the game, nor the reverse.
+/// After each batch of ticks, it publishes a snapshot of the game,
+/// which the thread that draws takes without waiting.
+/// The actions of the players are passed the other way,
+/// as the bits of an action_set in an atomic integer per player
+class simulation_thread
+{
+public:
+  /// @param g the game to tick. While the thread runs,
+  ///   no other thread may use it
+  /// @param log the log to record the ticks in
+  /// @param timestep decides how many ticks to do as time passes
+  simulation_thread(game& g, action_log& log, const fixed_timestep& timestep);
+
+  /// Stops the thread, if it runs
+  ~simulation_thread();
+
+  simulation_thread(const simulation_thread&) = delete;
+  simulation_thread& operator=(const simulation_thread&) = delete;
+
+  /// Start ticking the game on a thread of its own
+  void start();
+
+  /// Stop ticking the game, after which the game
+  /// can be used by the calling thread again
+  void stop();
+
+  bool is_running() const noexcept { return m_thread.joinable(); }
+
+  /// Set the actions of a player, used from the next tick on.
+  /// Can be called from any thread
+  void set_actions(const int i, const action_set& actions) noexcept;
+
+  /// Do the ticks that are due after some time passed,
+  /// and publish a snapshot if there were any.
+  /// The thread does this in a loop, only call it when it is not running.
+  /// Returns the number of ticks done
+  int advance(const double seconds);
+
+  /// Get the newest snapshot published. Only call this from one thread,
+  /// which is the thread that draws
+  const render_snapshot& get_newest_snapshot() noexcept;
+
+  /// The number of ticks done so far. Can be called from any thread
+  int get_n_ticks() const noexcept { return m_n_ticks.load(); }
+
+private:
+  game& m_game;
+  action_log& m_log;
+  fixed_timestep m_timestep;
+
+  /// The actions of each player, as the bits of an action_set
+  std::vector<std::atomic<unsigned int>> m_actions;
+
+  /// Where the things were before the latest tick
+  previous_state m_previous;
+
+  /// The snapshots, from the simulation thread to the thread that draws
+  triple_buffer<render_snapshot> m_snapshots;
+
+  std::atomic<int> m_n_ticks;
+  std::atomic<bool> m_must_stop;
+  std::thread m_thread;
+
+  /// The ID of the thread that ticks the game while it runs,
+  /// the default ID when it does not run
+  std::atomic<std::thread::id> m_ticking_thread_id;
+
+  /// Is the calling thread the only one that may use the game now?
+  bool may_use_game() const noexcept;
+
+  /// Tick the game until asked to stop
+  void run();
+
+  /// Do one tick, with the actions set
+  void tick();
+};
+
+/// Test the simulation_thread class
+void test_simulation_thread();
+
+#endif // SIMULATION_THREAD_H
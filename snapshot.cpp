@@ -0,0 +1,466 @@
+#include "snapshot.h"
+#include "binary_io.h"
+#include "headless_runner.h"
+#include "state_hash.h"
+
+#include <cassert>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// The first bytes of a snapshot
+static const char snapshot_magic[4] = {'G', 'S', 'N', 'P'};
+
+int get_snapshot_version() noexcept
+{
+  return 3;
+}
+
+static void put_coordinate(binary_writer& w, const coordinate& c)
+{
+  w.put_double(c.get_x());
+  w.put_double(c.get_y());
+}
+
+static coordinate get_coordinate(binary_reader& r)
+{
+  const double x{r.get_double()};
+  const double y{r.get_double()};
+  return coordinate(x, y);
+}
+
+static void put_color(binary_writer& w, const color& c)
+{
+  w.put_varint(static_cast<std::uint64_t>(c.get_red()));
+  w.put_varint(static_cast<std::uint64_t>(c.get_green()));
+  w.put_varint(static_cast<std::uint64_t>(c.get_blue()));
+  w.put_varint(static_cast<std::uint64_t>(c.get_opaqueness()));
+}
+
+static color get_color(binary_reader& r)
+{
+  const int red{static_cast<int>(r.get_varint(255))};
+  const int green{static_cast<int>(r.get_varint(255))};
+  const int blue{static_cast<int>(r.get_varint(255))};
+  const int opaqueness{static_cast<int>(r.get_varint(255))};
+  return color(red, green, blue, opaqueness);
+}
+
+static void put_rng(binary_writer& w, const fast_rng& rng)
+{
+  for (const auto s : rng.get_state()) w.put_u64(s);
+}
+
+static void get_rng(binary_reader& r, fast_rng& rng)
+{
+  std::array<std::uint64_t, 4> state;
+  for (auto& s : state) s = r.get_u64();
+  rng.set_state(state);
+}
+
+/// Get an int stored as a signed varint
+static int get_int(binary_reader& r)
+{
+  const std::int64_t i{r.get_signed_varint()};
+  if (i < INT_MIN || i > INT_MAX)
+    {
+      throw std::invalid_argument("Snapshot has a number that is too big");
+    }
+  return static_cast<int>(i);
+}
+
+/// Get a number of items. Each item takes at least as many bytes
+/// as its coordinate, so there cannot be more items than that
+static int get_n_items(binary_reader& r)
+{
+  const std::uint64_t min_n_bytes_per_item{16};
+  return static_cast<int>(r.get_varint(std::min<std::uint64_t>(INT_MAX, r.get_n_bytes_left() / min_n_bytes_per_item)));
+}
+
+static void put_player(binary_writer& w, const player& p)
+{
+  put_coordinate(w, p.get_position());
+  w.put_varint(static_cast<std::uint64_t>(p.get_shape()));
+  w.put_varint(static_cast<std::uint64_t>(p.get_state()));
+  w.put_double(p.get_max_speed());
+  w.put_double(p.get_acceleration());
+  w.put_double(p.get_deceleration());
+  w.put_double(p.get_acceleration_backward());
+  w.put_double(p.get_diameter());
+  w.put_double(p.get_turn_rate());
+  put_color(w, p.get_color());
+  w.put_signed_varint(p.get_ID());
+  w.put_double(p.get_speed());
+  w.put_double(p.get_direction());
+  w.put_double(p.get_health());
+  w.put_varint(p.get_action_set().get_bits());
+  w.put_varint((p.is_shooting() ? 1 : 0) | (p.is_shooting_stun_rocket() ? 2 : 0));
+}
+
+static player get_player(binary_reader& r)
+{
+  const coordinate c{get_coordinate(r)};
+  const auto shape = static_cast<player_shape>(r.get_varint(static_cast<std::uint64_t>(player_shape::square)));
+  const auto state = static_cast<player_state>(r.get_varint(static_cast<std::uint64_t>(player_state::stunned)));
+  const double max_speed{r.get_double()};
+  const double acceleration{r.get_double()};
+  const double deceleration{r.get_double()};
+  const double acc_backward{r.get_double()};
+  const double diameter{r.get_double()};
+  const double turn_rate{r.get_double()};
+  const color col{get_color(r)};
+  const int ID{get_int(r)};
+  player p(c, shape, state, max_speed, acceleration, deceleration,
+           acc_backward, diameter, turn_rate, col, ID);
+  p.set_speed(r.get_double());
+  p.set_direction(r.get_double());
+  p.set_health(r.get_double());
+  p.get_action_set().set_bits(static_cast<unsigned int>(r.get_varint(UINT_MAX)));
+  const std::uint64_t shooting{r.get_varint(3)};
+  if (shooting & 1) p.shoot();
+  if (shooting & 2) p.shoot_stun_rocket();
+  return p;
+}
+
+static void put_food(binary_writer& w, const food& f)
+{
+  put_coordinate(w, f.get_position());
+  put_color(w, f.get_color());
+  w.put_signed_varint(f.get_regeneration_time());
+  w.put_varint(static_cast<std::uint64_t>(f.get_food_state()));
+  w.put_double(f.get_radius());
+  w.put_signed_varint(f.get_eaten_at());
+}
+
+static food get_food(binary_reader& r)
+{
+  const coordinate c{get_coordinate(r)};
+  const color col{get_color(r)};
+  const int regeneration_time{get_int(r)};
+  const auto state = static_cast<food_state>(r.get_varint(static_cast<std::uint64_t>(food_state::uneaten)));
+  const double radius{r.get_double()};
+  food f(c, col, regeneration_time, state, radius);
+  f.set_eaten_at(get_int(r));
+  return f;
+}
+
+static void put_shelter(binary_writer& w, const shelter& s)
+{
+  put_coordinate(w, s.get_position());
+  w.put_double(s.get_radius());
+  put_color(w, s.get_color());
+  w.put_double(s.get_speed());
+  w.put_double(s.get_direction());
+}
+
+static shelter get_shelter(binary_reader& r)
+{
+  const coordinate c{get_coordinate(r)};
+  const double radius{r.get_double()};
+  const color col{get_color(r)};
+  const double speed{r.get_double()};
+  const double direction{r.get_double()};
+  return shelter(c, radius, col, speed, direction);
+}
+
+static void put_projectile(binary_writer& w, const projectile& p)
+{
+  put_coordinate(w, p.get_position());
+  w.put_double(p.get_direction());
+  w.put_varint(static_cast<std::uint64_t>(p.get_type()));
+  w.put_double(p.get_radius());
+  w.put_signed_varint(p.get_owner_id());
+  w.put_signed_varint(p.get_age());
+}
+
+static projectile get_projectile(binary_reader& r)
+{
+  const coordinate c{get_coordinate(r)};
+  const double direction{r.get_double()};
+  const auto type = static_cast<projectile_type>(r.get_varint(static_cast<std::uint64_t>(projectile_type::stun_rocket)));
+  const double radius{r.get_double()};
+  const int owner_id{get_int(r)};
+  projectile p(c, direction, type, radius, owner_id);
+  p.set_age(get_int(r));
+  return p;
+}
+
+void save_snapshot(const game& g, std::vector<std::uint8_t>& bytes)
+{
+  binary_writer w;
+  std::swap(w.get_bytes(), bytes);
+  w.put_bytes(snapshot_magic, sizeof(snapshot_magic));
+  w.put_varint(static_cast<std::uint64_t>(get_snapshot_version()));
+  w.put_signed_varint(g.get_seed());
+  w.put_signed_varint(g.get_n_ticks());
+  w.put_signed_varint(g.get_food_clock());
+  w.put_varint(static_cast<std::uint64_t>(g.get_food_placement()));
+  w.put_double(g.get_env().get_wall_s_side());
+  w.put_varint(static_cast<std::uint64_t>(g.get_env().get_type()));
+  w.put_varint(g.get_v_player().size());
+  w.put_varint(g.get_food().size());
+  w.put_varint(g.get_shelters().size());
+  w.put_varint(g.get_projectiles().size());
+  w.put_varint(g.get_enemies().size());
+
+  // The std::mt19937 state can only be read as text
+  std::stringstream rng_state;
+  rng_state << g.get_rng();
+  const std::string rng_chars{rng_state.str()};
+  w.put_varint(rng_chars.size());
+  w.put_bytes(rng_chars.data(), rng_chars.size());
+  put_rng(w, g.get_shelter_rng());
+  put_rng(w, g.get_food_rng());
+
+  for (const auto& p : g.get_v_player()) put_player(w, p);
+  for (const auto& f : g.get_food()) put_food(w, f);
+  for (const auto& s : g.get_shelters()) put_shelter(w, s);
+  for (const auto& p : g.get_projectiles()) put_projectile(w, p);
+  for (const auto& e : g.get_enemies()) put_coordinate(w, e.get_position());
+  std::swap(w.get_bytes(), bytes);
+}
+
+void save_snapshot(const game& g, std::ostream& os)
+{
+  std::vector<std::uint8_t> bytes;
+  save_snapshot(g, bytes);
+  os.write(reinterpret_cast<const char*>(bytes.data()),
+           static_cast<std::streamsize>(bytes.size()));
+}
+
+game load_snapshot(const std::uint8_t* data, const std::size_t n_bytes)
+{
+  binary_reader r(data, n_bytes);
+  char magic[sizeof(snapshot_magic)];
+  r.get_bytes(magic, sizeof(magic));
+  if (std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0)
+    {
+      throw std::invalid_argument("Data is not a snapshot");
+    }
+  if (r.get_varint() != static_cast<std::uint64_t>(get_snapshot_version()))
+    {
+      throw std::invalid_argument("Snapshot has an unknown version");
+    }
+  const int seed{get_int(r)};
+  const int n_ticks{get_int(r)};
+  const int food_clock{get_int(r)};
+  const auto placement = static_cast<food_placement>(
+    r.get_varint(static_cast<std::uint64_t>(food_placement::density_aware))
+  );
+  const double wall_short_side{r.get_double()};
+  const auto type = static_cast<environment_type>(
+    r.get_varint(static_cast<std::uint64_t>(environment_type::wormhole))
+  );
+
+  const int n_players{get_n_items(r)};
+  const int n_food{get_n_items(r)};
+  const int n_shelters{get_n_items(r)};
+  const int n_projectiles{get_n_items(r)};
+  const int n_enemies{get_n_items(r)};
+  if (static_cast<std::uint64_t>(n_players) + n_food + n_shelters + n_projectiles + n_enemies
+      > r.get_n_bytes_left() / 16)
+    {
+      throw std::invalid_argument("Snapshot ends too early");
+    }
+
+  // Create a game with the right number of items,
+  // then overwrite these with the items from the snapshot
+  game g(environment(wall_short_side, type),
+         n_players,
+         n_ticks,
+         static_cast<std::size_t>(n_shelters),
+         n_enemies,
+         n_food,
+         seed);
+
+  const std::size_t n_rng_chars{static_cast<std::size_t>(r.get_varint(r.get_n_bytes_left()))};
+  std::stringstream rng_state(std::string(reinterpret_cast<const char*>(r.get_position()), n_rng_chars));
+  r.skip(n_rng_chars);
+  rng_state >> g.get_rng();
+  if (!rng_state)
+    {
+      throw std::invalid_argument("Snapshot has an invalid random number generator state");
+    }
+  get_rng(r, g.get_shelter_rng());
+  get_rng(r, g.get_food_rng());
+
+  for (auto& p : g.get_v_player()) p = get_player(r);
+  for (int i = 0; i != n_food; ++i) g.set_food_item(i, get_food(r));
+  g.set_food_clock(food_clock);
+  g.set_food_placement(placement);
+  for (auto& s : g.get_shelters()) s = get_shelter(r);
+  for (int i = 0; i != n_projectiles; ++i)
+    {
+      if (!add_projectile(g, get_projectile(r)))
+        {
+          throw std::invalid_argument("Snapshot has more projectiles than a game can have");
+        }
+    }
+  for (auto& e : g.get_enemies()) e = enemy(get_coordinate(r));
+  if (!r.is_done())
+    {
+      throw std::invalid_argument("Snapshot has data after its end");
+    }
+  return g;
+}
+
+game load_snapshot(std::istream& is)
+{
+  const std::vector<std::uint8_t> bytes{
+    std::istreambuf_iterator<char>(is),
+    std::istreambuf_iterator<char>()
+  };
+  return load_snapshot(bytes.data(), bytes.size());
+}
+
+game load_snapshot_file(const std::string& path)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd{::open(path.c_str(), O_RDONLY)};
+  if (fd == -1)
+    {
+      throw std::invalid_argument("Cannot open snapshot '" + path + "'");
+    }
+  struct stat s;
+  if (::fstat(fd, &s) == -1 || s.st_size == 0)
+    {
+      ::close(fd);
+      throw std::invalid_argument("Cannot read snapshot '" + path + "'");
+    }
+  const std::size_t n_bytes{static_cast<std::size_t>(s.st_size)};
+  void* const data{::mmap(nullptr, n_bytes, PROT_READ, MAP_PRIVATE, fd, 0)};
+  ::close(fd);
+  if (data == MAP_FAILED)
+    {
+      throw std::invalid_argument("Cannot map snapshot '" + path + "'");
+    }
+  try
+  {
+    game g = load_snapshot(static_cast<const std::uint8_t*>(data), n_bytes);
+    ::munmap(data, n_bytes);
+    return g;
+  }
+  catch (...)
+  {
+    ::munmap(data, n_bytes);
+    throw;
+  }
+#else
+  std::ifstream f(path, std::ios::binary);
+  if (!f)
+    {
+      throw std::invalid_argument("Cannot open snapshot '" + path + "'");
+    }
+  return load_snapshot(f);
+#endif
+}
+
+void test_snapshot() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A game loaded from a snapshot is the same and plays on the same
+  {
+    game g = create_headless_game(headless_options(7, 20, 10, 30, 42));
+    for (int tick = 0; tick != 200; ++tick)
+      {
+        apply_scripted_actions(g, tick);
+        g.tick();
+      }
+    std::vector<std::uint8_t> bytes;
+    save_snapshot(g, bytes);
+    game h = load_snapshot(bytes.data(), bytes.size());
+    assert(calc_state_hash(h) == calc_state_hash(g));
+    assert(h.get_n_ticks() == 200);
+    assert(h.get_seed() == 42);
+    assert(h.get_player_name(6) == g.get_player_name(6));
+    for (int tick = 200; tick != 500; ++tick)
+      {
+        apply_scripted_actions(g, tick);
+        apply_scripted_actions(h, tick);
+        g.tick();
+        h.tick();
+      }
+    assert(calc_state_hash(h) == calc_state_hash(g));
+    assert(h.get_rng()() == g.get_rng()());
+  }
+  // A snapshot can be saved to and loaded from a stream
+  {
+    game g;
+    g.tick();
+    std::stringstream s;
+    save_snapshot(g, s);
+    const game h = load_snapshot(s);
+    assert(calc_state_hash(h) == calc_state_hash(g));
+  }
+  // A snapshot keeps how food is placed
+  {
+    game g;
+    g.set_food_placement(food_placement::density_aware);
+    std::vector<std::uint8_t> bytes;
+    save_snapshot(g, bytes);
+    const game h = load_snapshot(bytes.data(), bytes.size());
+    assert(h.get_food_placement() == food_placement::density_aware);
+  }
+  // A snapshot can be loaded from a file
+  {
+    game g(environment(), 4, 0, 3, 1, 5, 11);
+    g.tick();
+    const std::string path{"test_snapshot.gsnp"};
+    {
+      std::ofstream f(path, std::ios::binary);
+      save_snapshot(g, f);
+    }
+    const game h = load_snapshot_file(path);
+    std::remove(path.c_str());
+    assert(calc_state_hash(h) == calc_state_hash(g));
+  }
+  // Bad data and missing files are rejected
+  {
+    std::vector<std::uint8_t> good;
+    save_snapshot(game(), good);
+    std::vector<std::vector<std::uint8_t>> bads{
+      {},
+      std::vector<std::uint8_t>(good.begin(), good.end() - 1),
+      good,
+      good
+    };
+    bads[2][0] = 'X';
+    bads[3].push_back(0);
+    for (const auto& bad : bads)
+      {
+        bool has_thrown{false};
+        try
+        {
+          load_snapshot(bad.data(), bad.size());
+        }
+        catch (const std::invalid_argument&)
+        {
+          has_thrown = true;
+        }
+        assert(has_thrown);
+      }
+    bool has_thrown{false};
+    try
+    {
+      load_snapshot_file("nonexisting.gsnp");
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+#endif // no tests in release
+}
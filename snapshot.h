@@ -0,0 +1,46 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "game.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// A snapshot is the state of a game in the middle of a match, in a
+/// binary format that is the same on all machines: the number of ticks,
+/// the environment, the states of the random number generators and all
+/// players, food, shelters, projectiles and enemies. A game loaded from
+/// a snapshot plays on exactly like the game the snapshot was taken of.
+///
+/// The format starts with 'GSNP' and a version number,
+/// integers are varints and doubles are stored bit for bit
+
+/// The version of the snapshot format, increase it upon a change
+int get_snapshot_version() noexcept;
+
+/// Write the state of a game as a snapshot, appended to 'bytes'
+void save_snapshot(const game& g, std::vector<std::uint8_t>& bytes);
+
+/// Write the state of a game as a snapshot
+void save_snapshot(const game& g, std::ostream& os);
+
+/// Create a game from a snapshot in memory.
+/// Throws std::invalid_argument if the data is not a valid snapshot
+game load_snapshot(const std::uint8_t* data, const std::size_t n_bytes);
+
+/// Create a game from a snapshot.
+/// Throws std::invalid_argument if the data is not a valid snapshot
+game load_snapshot(std::istream& is);
+
+/// Create a game from a snapshot file. On Unix, the file is
+/// memory-mapped instead of read, so it is never copied.
+/// Throws std::invalid_argument if the file cannot be read
+/// or is not a valid snapshot
+game load_snapshot_file(const std::string& path);
+
+/// Test the snapshots
+void test_snapshot();
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,250 @@
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+spatial_grid::spatial_grid():
+  m_min_x{0.0},
+  m_min_y{0.0},
+  m_cell_size{1.0},
+  m_n_cols{1},
+  m_n_rows{1},
+  m_cell_start(2, 0)
+{
+}
+
+void spatial_grid::rebuild(const coordinate& top_left,
+                           const coordinate& bottom_right,
+                           const double cell_size,
+                           const std::vector<double>& xs,
+                           const std::vector<double>& ys)
+{
+  assert(cell_size > 0.0);
+  assert(xs.size() == ys.size());
+  const double width{std::max(bottom_right.get_x() - top_left.get_x(), 0.0)};
+  const double height{std::max(bottom_right.get_y() - top_left.get_y(), 0.0)};
+  const int max_n{get_max_n_cells_per_axis()};
+
+  m_min_x = top_left.get_x();
+  m_min_y = top_left.get_y();
+  m_cell_size = std::max(cell_size, std::max(width, height) / max_n);
+  m_n_cols = std::max(1, std::min(max_n, static_cast<int>(std::ceil(width / m_cell_size))));
+  m_n_rows = std::max(1, std::min(max_n, static_cast<int>(std::ceil(height / m_cell_size))));
+
+  // Counting sort of the items by cell, items in a cell keep their order
+  const int n_cells{m_n_cols * m_n_rows};
+  const int n_items{static_cast<int>(xs.size())};
+  m_cell_start.assign(static_cast<std::size_t>(n_cells + 1), 0);
+  m_cell_of_item.resize(xs.size());
+  for (int i = 0; i != n_items; ++i)
+    {
+      const int cell{(get_row(ys[i]) * m_n_cols) + get_col(xs[i])};
+      m_cell_of_item[i] = cell;
+      ++m_cell_start[cell];
+    }
+  // Now m_cell_start[c] is the number of items in cell c,
+  // make it the index just past the last item of cell c
+  for (int c = 1; c != n_cells; ++c)
+    {
+      m_cell_start[c] += m_cell_start[c - 1];
+    }
+  m_cell_start[n_cells] = n_items;
+  // Fill each cell from its back, after which
+  // m_cell_start[c] is the index of the first item of cell c
+  m_items.resize(xs.size());
+  for (int i = n_items - 1; i >= 0; --i)
+    {
+      m_items[--m_cell_start[m_cell_of_item[i]]] = i;
+    }
+}
+
+int spatial_grid::get_col(const double x) const noexcept
+{
+  const double col{(x - m_min_x) / m_cell_size};
+  if (!(col >= 0.0)) return 0; // Also catches NaN
+  if (col >= m_n_cols) return m_n_cols - 1;
+  return static_cast<int>(col);
+}
+
+int spatial_grid::get_row(const double y) const noexcept
+{
+  const double row{(y - m_min_y) / m_cell_size};
+  if (!(row >= 0.0)) return 0; // Also catches NaN
+  if (row >= m_n_rows) return m_n_rows - 1;
+  return static_cast<int>(row);
+}
+
+void spatial_grid::add_pairs(const int cell_a,
+                             const int cell_b,
+                             std::vector<std::pair<int, int>>& pairs) const
+{
+  for (int a = m_cell_start[cell_a]; a != m_cell_start[cell_a + 1]; ++a)
+    {
+      for (int b = m_cell_start[cell_b]; b != m_cell_start[cell_b + 1]; ++b)
+        {
+          const int i{m_items[a]};
+          const int j{m_items[b]};
+          pairs.push_back(i < j ? std::make_pair(i, j) : std::make_pair(j, i));
+        }
+    }
+}
+
+void spatial_grid::get_candidate_pairs(std::vector<std::pair<int, int>>& pairs) const
+{
+  pairs.clear();
+  for (int row = 0; row != m_n_rows; ++row)
+    {
+      for (int col = 0; col != m_n_cols; ++col)
+        {
+          const int cell{(row * m_n_cols) + col};
+          const int begin{m_cell_start[cell]};
+          const int end{m_cell_start[cell + 1]};
+          if (begin == end) continue;
+
+          // Pairs within the cell, items in a cell are in increasing order
+          for (int a = begin; a != end; ++a)
+            {
+              for (int b = a + 1; b != end; ++b)
+                {
+                  pairs.push_back(std::make_pair(m_items[a], m_items[b]));
+                }
+            }
+          // Pairs with half of the neighbours, the other half
+          // of the neighbours will find this cell
+          const bool has_right{col + 1 != m_n_cols};
+          const bool has_below{row + 1 != m_n_rows};
+          if (has_right) add_pairs(cell, cell + 1, pairs);
+          if (has_below)
+            {
+              const int below{cell + m_n_cols};
+              if (col != 0) add_pairs(cell, below - 1, pairs);
+              add_pairs(cell, below, pairs);
+              if (has_right) add_pairs(cell, below + 1, pairs);
+            }
+        }
+    }
+  std::sort(std::begin(pairs), std::end(pairs));
+}
+
+void spatial_grid::query(const double min_x,
+                         const double min_y,
+                         const double max_x,
+                         const double max_y,
+                         std::vector<int>& indices) const
+{
+  const std::size_t n_before{indices.size()};
+  const int col_begin{get_col(min_x)};
+  const int col_end{get_col(max_x) + 1};
+  const int row_begin{get_row(min_y)};
+  const int row_end{get_row(max_y) + 1};
+  for (int row = row_begin; row < row_end; ++row)
+    {
+      for (int col = col_begin; col < col_end; ++col)
+        {
+          const int cell{(row * m_n_cols) + col};
+          for (int a = m_cell_start[cell]; a != m_cell_start[cell + 1]; ++a)
+            {
+              indices.push_back(m_items[a]);
+            }
+        }
+    }
+  std::sort(std::begin(indices) + static_cast<std::ptrdiff_t>(n_before), std::end(indices));
+}
+
+void test_spatial_grid() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  const coordinate top_left(0.0, 0.0);
+  const coordinate bottom_right(1000.0, 500.0);
+  // An empty grid has no pairs
+  {
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, {}, {});
+    std::vector<std::pair<int, int>> pairs;
+    g.get_candidate_pairs(pairs);
+    assert(pairs.empty());
+    assert(g.get_n_items() == 0);
+  }
+  // The grid has enough cells to cover the rectangle
+  {
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, {}, {});
+    assert(g.get_n_cols() == 10);
+    assert(g.get_n_rows() == 5);
+  }
+  // Tiny cells do not make a huge grid
+  {
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, 0.001, {}, {});
+    assert(g.get_n_cols() <= spatial_grid::get_max_n_cells_per_axis());
+    assert(g.get_n_rows() <= spatial_grid::get_max_n_cells_per_axis());
+    assert(g.get_cell_size() > 0.001);
+  }
+  // Two close items form a pair, also when in neighbouring cells
+  {
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, {10.0, 150.0, 900.0, 195.0}, {10.0, 10.0, 400.0, 105.0});
+    std::vector<std::pair<int, int>> pairs;
+    g.get_candidate_pairs(pairs);
+    assert(std::count(std::begin(pairs), std::end(pairs), std::make_pair(1, 3)) == 1);
+    assert(std::count(std::begin(pairs), std::end(pairs), std::make_pair(0, 2)) == 0);
+    assert(std::count(std::begin(pairs), std::end(pairs), std::make_pair(1, 2)) == 0);
+  }
+  // Items outside of the rectangle go to the nearest cell
+  {
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, {-50.0, -10.0, 2000.0}, {-50.0, 20.0, 0.0});
+    std::vector<std::pair<int, int>> pairs;
+    g.get_candidate_pairs(pairs);
+    assert(pairs.size() == 1);
+    assert(pairs[0] == std::make_pair(0, 1));
+  }
+  // The grid finds all pairs that are less than a cell size apart,
+  // without duplicates, in the same order as a loop over all pairs
+  {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> x(-100.0, 1100.0);
+    std::uniform_real_distribution<double> y(-100.0, 600.0);
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (int i = 0; i != 300; ++i)
+      {
+        xs.push_back(x(rng));
+        ys.push_back(y(rng));
+      }
+    const double cell_size{37.0};
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, cell_size, xs, ys);
+    std::vector<std::pair<int, int>> pairs;
+    g.get_candidate_pairs(pairs);
+    assert(std::is_sorted(std::begin(pairs), std::end(pairs)));
+    assert(std::adjacent_find(std::begin(pairs), std::end(pairs)) == std::end(pairs));
+    // All pairs less than a cell size apart, by comparing all pairs
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i != 300; ++i)
+      {
+        for (int j = i + 1; j != 300; ++j)
+          {
+            if (std::abs(xs[i] - xs[j]) < cell_size && std::abs(ys[i] - ys[j]) < cell_size)
+              {
+                expected.push_back(std::make_pair(i, j));
+              }
+          }
+      }
+    assert(std::includes(std::begin(pairs), std::end(pairs), std::begin(expected), std::end(expected)));
+  }
+  // A query gives all items in the overlapping cells, sorted
+  {
+    spatial_grid g;
+    g.rebuild(top_left, bottom_right, 100.0, {450.0, 10.0, 420.0, 800.0}, {250.0, 10.0, 280.0, 250.0});
+    std::vector<int> indices;
+    g.query(400.0, 200.0, 499.0, 299.0, indices);
+    assert(indices == std::vector<int>({0, 2}));
+    indices.clear();
+    g.query(-1000.0, -1000.0, 5000.0, 5000.0, indices);
+    assert(indices == std::vector<int>({0, 1, 2, 3}));
+  }
+#endif // no tests in release
+}
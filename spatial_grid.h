@@ -0,0 +1,90 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "coordinate.h"
+#include <utility>
+#include <vector>
+
+/// A uniform grid over a rectangle, to quickly find the items
+/// that are near each other, without comparing all pairs of items.
+/// The grid is rebuilt from scratch when the items move,
+/// which costs one pass over the items and one over the cells.
+/// Items outside of the rectangle are put in the nearest cell at the border
+class spatial_grid
+{
+public:
+  spatial_grid();
+
+  /// Put the items in the grid, removing the earlier ones.
+  /// Item i is at (xs[i], ys[i]).
+  /// @param top_left the top-left corner of the rectangle covered by the grid
+  /// @param bottom_right the bottom-right corner of the rectangle covered by the grid
+  /// @param cell_size the minimal width and height of a cell. The grid finds all
+  ///   pairs of items that are less than a cell size apart horizontally and vertically
+  void rebuild(const coordinate& top_left,
+               const coordinate& bottom_right,
+               const double cell_size,
+               const std::vector<double>& xs,
+               const std::vector<double>& ys);
+
+  /// Get all pairs of items that are in the same or in neighbouring cells.
+  /// Each pair has the lowest index first and the pairs are sorted,
+  /// so the pairs are in the same order as a loop over all pairs would give.
+  /// The pairs are written to 'pairs', which is cleared first
+  void get_candidate_pairs(std::vector<std::pair<int, int>>& pairs) const;
+
+  /// Get all items in the cells that overlap with a rectangle,
+  /// in increasing order of index. These are appended to 'indices'
+  void query(const double min_x,
+             const double min_y,
+             const double max_x,
+             const double max_y,
+             std::vector<int>& indices) const;
+
+  /// The width and height of a cell, which can be bigger than
+  /// requested, as the number of cells per axis is limited
+  double get_cell_size() const noexcept { return m_cell_size; }
+
+  int get_n_cols() const noexcept { return m_n_cols; }
+  int get_n_rows() const noexcept { return m_n_rows; }
+
+  /// The number of items in the grid
+  int get_n_items() const noexcept { return static_cast<int>(m_items.size()); }
+
+  /// The maximum number of cells along each axis,
+  /// so that tiny cells do not make a huge grid
+  static int get_max_n_cells_per_axis() noexcept { return 256; }
+
+private:
+  double m_min_x;
+  double m_min_y;
+  double m_cell_size;
+  int m_n_cols;
+  int m_n_rows;
+
+  /// For each cell, the index of its first item in m_items,
+  /// has one extra element at the end
+  std::vector<int> m_cell_start;
+
+  /// The item indices, sorted by cell
+  std::vector<int> m_items;
+
+  /// The cell index of each item
+  std::vector<int> m_cell_of_item;
+
+  /// Get the column a x coordinate is in, clamped to the grid
+  int get_col(const double x) const noexcept;
+
+  /// Get the row a y coordinate is in, clamped to the grid
+  int get_row(const double y) const noexcept;
+
+  /// Add the pairs between the items of two different cells
+  void add_pairs(const int cell_a,
+                 const int cell_b,
+                 std::vector<std::pair<int, int>>& pairs) const;
+};
+
+/// Test the spatial grid
+void test_spatial_grid();
+
+#endif // SPATIAL_GRID_H
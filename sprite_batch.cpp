@@ -0,0 +1,257 @@
+#include "sprite_batch.h"
+
+#ifndef LOGIC_ONLY // that is, not compiled on GitHub Actions
+
+#include <cassert>
+#include <cmath>
+
+sprite_batch::sprite_batch():
+  m_n_batches{0},
+  m_layer_begin{0}
+{
+}
+
+void sprite_batch::clear() noexcept
+{
+  for (std::size_t i = 0; i != m_n_batches; ++i)
+    {
+      m_batches[i].m_vertices.clear();
+    }
+  m_n_batches = 0;
+  m_layer_begin = 0;
+}
+
+sf::VertexArray& sprite_batch::get_batch(const sf::Texture* texture)
+{
+  for (std::size_t i = m_layer_begin; i != m_n_batches; ++i)
+    {
+      if (m_batches[i].m_texture == texture) return m_batches[i].m_vertices;
+    }
+  if (m_n_batches == m_batches.size())
+    {
+      m_batches.push_back(batch{nullptr, sf::VertexArray(sf::Triangles)});
+    }
+  batch& b = m_batches[m_n_batches++];
+  b.m_texture = texture;
+  b.m_vertices.clear();
+  return b.m_vertices;
+}
+
+/// Rotates and moves points from the local coordinates of a sprite
+/// to the world, like the transform of an sf::Transformable
+class sprite_transform
+{
+public:
+  sprite_transform(const sf::Vector2f& position,
+                   const sf::Vector2f& origin,
+                   const float rotation):
+    m_position{position},
+    m_origin{origin},
+    m_cos{static_cast<float>(std::cos(rotation * M_PI / 180.0))},
+    m_sin{static_cast<float>(std::sin(rotation * M_PI / 180.0))}
+  {
+  }
+  sf::Vector2f operator()(const float x, const float y) const noexcept
+  {
+    const float dx{x - m_origin.x};
+    const float dy{y - m_origin.y};
+    return sf::Vector2f(m_position.x + (dx * m_cos) - (dy * m_sin),
+                        m_position.y + (dx * m_sin) + (dy * m_cos));
+  }
+private:
+  sf::Vector2f m_position;
+  sf::Vector2f m_origin;
+  float m_cos;
+  float m_sin;
+};
+
+void sprite_batch::add_rectangle(const sf::Texture* texture,
+                                 const sf::FloatRect& texture_rect,
+                                 const sf::Vector2f& position,
+                                 const sf::Vector2f& size,
+                                 const sf::Vector2f& origin,
+                                 const float rotation,
+                                 const sf::Color& color)
+{
+  const sprite_transform t(position, origin, rotation);
+  const float u0{texture_rect.left};
+  const float v0{texture_rect.top};
+  const float u1{texture_rect.left + texture_rect.width};
+  const float v1{texture_rect.top + texture_rect.height};
+  const sf::Vertex top_left(t(0.0f, 0.0f), color, sf::Vector2f(u0, v0));
+  const sf::Vertex top_right(t(size.x, 0.0f), color, sf::Vector2f(u1, v0));
+  const sf::Vertex bottom_right(t(size.x, size.y), color, sf::Vector2f(u1, v1));
+  const sf::Vertex bottom_left(t(0.0f, size.y), color, sf::Vector2f(u0, v1));
+  sf::VertexArray& v = get_batch(texture);
+  v.append(top_left);
+  v.append(top_right);
+  v.append(bottom_right);
+  v.append(top_left);
+  v.append(bottom_right);
+  v.append(bottom_left);
+}
+
+void sprite_batch::add_circle(const sf::Texture* texture,
+                              const sf::FloatRect& texture_rect,
+                              const sf::Vector2f& position,
+                              const float radius,
+                              const sf::Vector2f& origin,
+                              const float rotation,
+                              const sf::Color& color,
+                              const int n_points)
+{
+  assert(n_points >= 3);
+  const sprite_transform t(position, origin, rotation);
+  const float diameter{2.0f * radius};
+  // Where a point of the square around the circle is on the texture
+  const auto get_vertex = [&](const float x, const float y)
+  {
+    const float u{diameter > 0.0f ? x / diameter : 0.0f};
+    const float v{diameter > 0.0f ? y / diameter : 0.0f};
+    return sf::Vertex(t(x, y), color,
+                      sf::Vector2f(texture_rect.left + (u * texture_rect.width),
+                                   texture_rect.top + (v * texture_rect.height)));
+  };
+  // The points start at the top, like those of an sf::CircleShape
+  const auto get_point = [&](const int i)
+  {
+    const double angle{(i * 2.0 * M_PI / n_points) - (M_PI / 2.0)};
+    return get_vertex(radius + (radius * static_cast<float>(std::cos(angle))),
+                      radius + (radius * static_cast<float>(std::sin(angle))));
+  };
+  const sf::Vertex center{get_vertex(radius, radius)};
+  sf::VertexArray& v = get_batch(texture);
+  sf::Vertex previous{get_point(0)};
+  for (int i = 1; i <= n_points; ++i)
+    {
+      const sf::Vertex next{get_point(i % n_points)};
+      v.append(center);
+      v.append(previous);
+      v.append(next);
+      previous = next;
+    }
+}
+
+void sprite_batch::draw(sf::RenderTarget& target) const
+{
+  for (std::size_t i = 0; i != m_n_batches; ++i)
+    {
+      const batch& b = m_batches[i];
+      if (b.m_vertices.getVertexCount() == 0) continue;
+      target.draw(b.m_vertices, sf::RenderStates(b.m_texture));
+    }
+}
+
+const sf::VertexArray& sprite_batch::get_vertices(const int i) const
+{
+  assert(i >= 0);
+  assert(i < get_n_batches());
+  return m_batches[static_cast<std::size_t>(i)].m_vertices;
+}
+
+const sf::Texture* sprite_batch::get_texture(const int i) const
+{
+  assert(i >= 0);
+  assert(i < get_n_batches());
+  return m_batches[static_cast<std::size_t>(i)].m_texture;
+}
+
+sf::FloatRect get_texture_rect(const sf::Texture& texture)
+{
+  return sf::FloatRect(0.0f, 0.0f,
+                       static_cast<float>(texture.getSize().x),
+                       static_cast<float>(texture.getSize().y));
+}
+
+void test_sprite_batch() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  sf::Texture a;
+  a.create(64, 32);
+  sf::Texture b;
+  b.create(16, 16);
+  const auto is_near = [](const sf::Vector2f& p, const float x, const float y)
+  {
+    return std::abs(p.x - x) < 0.001f && std::abs(p.y - y) < 0.001f;
+  };
+  // An empty batch draws nothing
+  {
+    const sprite_batch s;
+    assert(s.get_n_batches() == 0);
+  }
+  // Sprites with the same texture share a batch, in the order these are added
+  {
+    sprite_batch s;
+    const sf::Vector2f size(10.0f, 10.0f);
+    const sf::Vector2f origin(0.0f, 0.0f);
+    for (int i = 0; i != 100; ++i)
+      {
+        const sf::Vector2f position(static_cast<float>(i), 0.0f);
+        s.add_rectangle(&a, get_texture_rect(a), position, size, origin, 0.0f);
+        s.add_rectangle(&b, get_texture_rect(b), position, size, origin, 0.0f);
+        s.add_circle(nullptr, sf::FloatRect(), position, 5.0f, origin, 0.0f, sf::Color::Red, 10);
+      }
+    assert(s.get_n_batches() == 3);
+    assert(s.get_texture(0) == &a);
+    assert(s.get_texture(1) == &b);
+    assert(s.get_texture(2) == nullptr);
+    assert(s.get_vertices(0).getVertexCount() == 600);
+    assert(s.get_vertices(2).getVertexCount() == 3000);
+    assert(is_near(s.get_vertices(0)[6].position, 1.0f, 0.0f));
+  }
+  // A rectangle has the texture coordinates of its part of the texture,
+  // and is rotated around its origin
+  {
+    sprite_batch s;
+    s.add_rectangle(&a, sf::FloatRect(8.0f, 4.0f, 16.0f, 8.0f),
+                    sf::Vector2f(100.0f, 50.0f), sf::Vector2f(20.0f, 10.0f),
+                    sf::Vector2f(0.0f, 0.0f), 90.0f);
+    const sf::VertexArray& v = s.get_vertices(0);
+    assert(v.getVertexCount() == 6);
+    assert(v[0].texCoords == sf::Vector2f(8.0f, 4.0f));
+    assert(v[2].texCoords == sf::Vector2f(24.0f, 12.0f));
+    // The top-left corner is at the position, the top-right corner
+    // is rotated clockwise, so it is below it
+    assert(is_near(v[0].position, 100.0f, 50.0f));
+    assert(is_near(v[1].position, 100.0f, 70.0f));
+    assert(is_near(v[2].position, 90.0f, 70.0f));
+  }
+  // A circle around its center is around its position
+  {
+    sprite_batch s;
+    s.add_circle(&b, get_texture_rect(b), sf::Vector2f(10.0f, 20.0f), 5.0f,
+                 sf::Vector2f(5.0f, 5.0f), 0.0f);
+    const sf::VertexArray& v = s.get_vertices(0);
+    assert(v.getVertexCount() == 90);
+    assert(is_near(v[0].position, 10.0f, 20.0f));
+    assert(v[0].texCoords == sf::Vector2f(8.0f, 8.0f));
+    // The first point is at the top
+    assert(is_near(v[1].position, 10.0f, 15.0f));
+  }
+  // A new layer has batches of its own
+  {
+    sprite_batch s;
+    const sf::Vector2f p(0.0f, 0.0f);
+    s.add_circle(nullptr, sf::FloatRect(), p, 5.0f, p, 0.0f);
+    s.add_rectangle(&a, get_texture_rect(a), p, p, p, 0.0f);
+    s.start_layer();
+    s.add_circle(nullptr, sf::FloatRect(), p, 5.0f, p, 0.0f);
+    assert(s.get_n_batches() == 3);
+    assert(s.get_texture(2) == nullptr);
+  }
+  // Clearing removes all batches
+  {
+    sprite_batch s;
+    const sf::Vector2f p(0.0f, 0.0f);
+    s.add_rectangle(&a, get_texture_rect(a), p, p, p, 0.0f);
+    s.clear();
+    assert(s.get_n_batches() == 0);
+    s.add_rectangle(&b, get_texture_rect(b), p, p, p, 0.0f);
+    assert(s.get_n_batches() == 1);
+    assert(s.get_texture(0) == &b);
+    assert(s.get_vertices(0).getVertexCount() == 6);
+  }
+#endif // no tests in release
+}
+
+#endif // LOGIC_ONLY // that is, not compiled on GitHub Actions
@@ -0,0 +1,100 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#ifndef LOGIC_ONLY // that is, not compiled on GitHub Actions
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// Collects textured rectangles and circles in one sf::VertexArray
+/// per texture, to draw all sprites with one draw call per texture,
+/// instead of one draw call per sprite.
+/// Sprites with the same texture are drawn in the order these are added.
+/// The batches keep their memory after a 'clear', so that building
+/// the same number of sprites each frame does not allocate
+class sprite_batch
+{
+public:
+  sprite_batch();
+
+  /// Remove all sprites, keeping the memory of the batches
+  void clear() noexcept;
+
+  /// Start a new layer: the sprites added from now on are drawn
+  /// on top of all sprites added before, in batches of their own
+  void start_layer() noexcept { m_layer_begin = m_n_batches; }
+
+  /// Add a rectangle, like an sf::RectangleShape
+  /// @param texture the texture, nullptr for a plain colored rectangle
+  /// @param texture_rect the part of the texture to show, in pixels
+  /// @param position the position of the origin
+  /// @param size the width and height
+  /// @param origin the point the rectangle is positioned and rotated around,
+  ///   relative to its top-left corner
+  /// @param rotation the rotation, in degrees, clockwise
+  /// @param color the color the texture is multiplied with
+  void add_rectangle(const sf::Texture* texture,
+                     const sf::FloatRect& texture_rect,
+                     const sf::Vector2f& position,
+                     const sf::Vector2f& size,
+                     const sf::Vector2f& origin,
+                     const float rotation,
+                     const sf::Color& color = sf::Color::White);
+
+  /// Add a circle, like an sf::CircleShape, the texture covers
+  /// the square around the circle
+  /// @param origin the point the circle is positioned and rotated around,
+  ///   relative to the top-left corner of the square around it
+  /// @param n_points the number of points on the circle
+  void add_circle(const sf::Texture* texture,
+                  const sf::FloatRect& texture_rect,
+                  const sf::Vector2f& position,
+                  const float radius,
+                  const sf::Vector2f& origin,
+                  const float rotation,
+                  const sf::Color& color = sf::Color::White,
+                  const int n_points = 30);
+
+  /// Draw all batches, one draw call per batch
+  void draw(sf::RenderTarget& target) const;
+
+  /// The number of batches, which is the number of draw calls
+  int get_n_batches() const noexcept { return static_cast<int>(m_n_batches); }
+
+  /// The vertices of a batch, three per triangle
+  const sf::VertexArray& get_vertices(const int i) const;
+
+  /// The texture of a batch, nullptr if it has no texture
+  const sf::Texture* get_texture(const int i) const;
+
+private:
+  /// The sprites with the same texture, in the same layer
+  struct batch
+  {
+    const sf::Texture* m_texture;
+    sf::VertexArray m_vertices;
+  };
+
+  /// The batches, of which the first m_n_batches are in use
+  std::vector<batch> m_batches;
+
+  /// The number of batches in use
+  std::size_t m_n_batches;
+
+  /// The first batch of the current layer
+  std::size_t m_layer_begin;
+
+  /// Get the vertices of the batch with a texture in the current layer,
+  /// starting a batch if there is none
+  sf::VertexArray& get_batch(const sf::Texture* texture);
+};
+
+/// Get the part of a texture that is all of it
+sf::FloatRect get_texture_rect(const sf::Texture& texture);
+
+/// Test the sprite batch
+void test_sprite_batch();
+
+#endif // LOGIC_ONLY // that is, not compiled on GitHub Actions
+
+#endif // SPRITE_BATCH_H
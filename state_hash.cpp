@@ -0,0 +1,121 @@
+#include "state_hash.h"
+#include "game.h"
+
+#include <cassert>
+#include <cstring>
+
+void fnv1a_hash::add(const std::uint64_t x) noexcept
+{
+  for (int i = 0; i != 8; ++i)
+    {
+      m_hash ^= (x >> (8 * i)) & 0xFF;
+      m_hash *= 1099511628211ull;
+    }
+}
+
+void fnv1a_hash::add(const int x) noexcept
+{
+  add(static_cast<std::uint64_t>(static_cast<std::int64_t>(x)));
+}
+
+void fnv1a_hash::add(const double x) noexcept
+{
+  std::uint64_t u{0};
+  std::memcpy(&u, &x, sizeof(u));
+  add(u);
+}
+
+std::uint64_t calc_state_hash(const game& g) noexcept
+{
+  fnv1a_hash h;
+  h.add(g.get_n_ticks());
+  h.add(g.get_food_clock());
+  for (const auto& p : g.get_v_player())
+    {
+      h.add(p.get_x());
+      h.add(p.get_y());
+      h.add(p.get_direction());
+      h.add(p.get_speed());
+      h.add(p.get_diameter());
+      h.add(p.get_health());
+      h.add(static_cast<int>(p.get_state()));
+      h.add(static_cast<std::uint64_t>(p.get_action_set().get_bits()));
+    }
+  for (const auto& f : g.get_food())
+    {
+      h.add(f.get_x());
+      h.add(f.get_y());
+      h.add(static_cast<int>(f.get_food_state()));
+      h.add(f.get_eaten_at());
+    }
+  for (const auto& s : g.get_shelters())
+    {
+      h.add(s.get_x());
+      h.add(s.get_y());
+    }
+  for (const auto& p : g.get_projectiles())
+    {
+      h.add(p.get_x());
+      h.add(p.get_y());
+      h.add(p.get_direction());
+      h.add(static_cast<int>(p.get_type()));
+      h.add(p.get_age());
+      h.add(p.get_owner_id());
+    }
+  for (const auto& e : g.get_enemies())
+    {
+      h.add(e.get_x());
+      h.add(e.get_y());
+    }
+  return h.get();
+}
+
+void test_state_hash() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // The empty FNV-1a hash is its offset basis
+  {
+    assert(fnv1a_hash().get() == 14695981039346656037ull);
+  }
+  // Different numbers give different hashes
+  {
+    fnv1a_hash a;
+    fnv1a_hash b;
+    a.add(1);
+    b.add(2);
+    assert(a.get() != b.get());
+  }
+  // Two identical games have the same hash, also after ticking
+  {
+    game a;
+    game b;
+    assert(calc_state_hash(a) == calc_state_hash(b));
+    a.tick();
+    b.tick();
+    assert(calc_state_hash(a) == calc_state_hash(b));
+  }
+  // A tick changes the hash
+  {
+    game g;
+    const std::uint64_t before{calc_state_hash(g)};
+    g.tick();
+    assert(calc_state_hash(g) != before);
+  }
+  // A player that moves a tiny bit changes the hash
+  {
+    game a;
+    game b;
+    b.get_player(0).place_to_position(coordinate(
+      b.get_player(0).get_x() + 0.000001, b.get_player(0).get_y()
+    ));
+    assert(calc_state_hash(a) != calc_state_hash(b));
+  }
+  // A different action changes the hash
+  {
+    game a;
+    game b;
+    b.get_player(1).get_action_set().insert(action_type::accelerate);
+    assert(calc_state_hash(a) != calc_state_hash(b));
+  }
+#endif // no tests in release
+}
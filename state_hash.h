@@ -0,0 +1,37 @@
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+#include <cstdint>
+
+class game;
+
+/// A 64-bit FNV-1a hash, built up from numbers.
+/// Numbers are added byte by byte, lowest byte first,
+/// so the hash is the same on all machines
+class fnv1a_hash
+{
+public:
+  fnv1a_hash() noexcept : m_hash{14695981039346656037ull} {}
+
+  void add(const std::uint64_t x) noexcept;
+  void add(const int x) noexcept;
+
+  /// Add a double, bit for bit
+  void add(const double x) noexcept;
+
+  std::uint64_t get() const noexcept { return m_hash; }
+
+private:
+  std::uint64_t m_hash;
+};
+
+/// Calculate a hash of the state of a game: the number of ticks,
+/// the players, food, shelters, projectiles and enemies.
+/// Two games that have run the same ticks have the same hash,
+/// a game that has a different hash has diverged
+std::uint64_t calc_state_hash(const game& g) noexcept;
+
+/// Test the state hash
+void test_state_hash();
+
+#endif // STATE_HASH_H
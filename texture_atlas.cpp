@@ -0,0 +1,185 @@
+#include "texture_atlas.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+std::vector<sf::Vector2u> pack_on_shelves(const std::vector<sf::Vector2u>& sizes,
+                                          const unsigned width,
+                                          const unsigned padding,
+                                          unsigned& height)
+{
+  // Take the tallest rectangles first, keep the order of equally tall ones
+  std::vector<std::size_t> order(sizes.size());
+  std::iota(std::begin(order), std::end(order), 0);
+  std::stable_sort(std::begin(order), std::end(order),
+                   [&sizes](const std::size_t lhs, const std::size_t rhs)
+                   {
+                     return sizes[lhs].y > sizes[rhs].y;
+                   });
+
+  std::vector<sf::Vector2u> corners(sizes.size());
+  unsigned shelf_top{0};
+  unsigned shelf_height{0};
+  unsigned x{0};
+  for (const std::size_t i : order)
+    {
+      const sf::Vector2u& size = sizes[i];
+      if (size.x > width)
+        {
+          throw std::invalid_argument("A rectangle is wider than the shelves");
+        }
+      if (x + size.x > width)
+        {
+          // Start a new shelf
+          shelf_top += shelf_height + padding;
+          shelf_height = 0;
+          x = 0;
+        }
+      corners[i] = sf::Vector2u(x, shelf_top);
+      x += size.x + padding;
+      shelf_height = std::max(shelf_height, size.y);
+    }
+  height = shelf_top + shelf_height;
+  return corners;
+}
+
+unsigned get_shelf_width(const std::vector<sf::Vector2u>& sizes,
+                         const unsigned padding)
+{
+  double area{0.0};
+  unsigned max_width{1};
+  for (const auto& size : sizes)
+    {
+      area += static_cast<double>(size.x + padding) * static_cast<double>(size.y + padding);
+      max_width = std::max(max_width, size.x);
+    }
+  const unsigned min_width{std::max(max_width, static_cast<unsigned>(std::ceil(std::sqrt(area))))};
+  unsigned width{1};
+  while (width < min_width) width *= 2;
+  return width;
+}
+
+texture_atlas::texture_atlas()
+{
+}
+
+void texture_atlas::build(const std::vector<sf::Image>& images, const unsigned padding)
+{
+  std::vector<sf::Vector2u> sizes;
+  for (const auto& image : images) sizes.push_back(image.getSize());
+  const unsigned width{get_shelf_width(sizes, padding)};
+  unsigned height{0};
+  const std::vector<sf::Vector2u> corners{pack_on_shelves(sizes, width, padding, height)};
+  if (width > sf::Texture::getMaximumSize() || height > sf::Texture::getMaximumSize())
+    {
+      throw std::runtime_error("The images do not fit in one texture");
+    }
+
+  sf::Image atlas;
+  atlas.create(width, std::max(height, 1u), sf::Color(0, 0, 0, 0));
+  m_rects.clear();
+  for (std::size_t i = 0; i != images.size(); ++i)
+    {
+      atlas.copy(images[i], corners[i].x, corners[i].y);
+      m_rects.push_back(sf::FloatRect(static_cast<float>(corners[i].x),
+                                      static_cast<float>(corners[i].y),
+                                      static_cast<float>(sizes[i].x),
+                                      static_cast<float>(sizes[i].y)));
+    }
+  if (!m_texture.loadFromImage(atlas))
+    {
+      throw std::runtime_error("Cannot create the texture of the atlas");
+    }
+}
+
+const sf::FloatRect& texture_atlas::get_rect(const int i) const
+{
+  assert(i >= 0);
+  assert(i < get_n_images());
+  return m_rects[static_cast<std::size_t>(i)];
+}
+
+void test_texture_atlas() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // Rectangles on shelves do not overlap and stay within the width
+  {
+    const std::vector<sf::Vector2u> sizes{
+      {30, 10}, {20, 40}, {50, 20}, {10, 10}, {64, 5}, {25, 40}
+    };
+    const unsigned width{64};
+    const unsigned padding{2};
+    unsigned height{0};
+    const std::vector<sf::Vector2u> corners{pack_on_shelves(sizes, width, padding, height)};
+    assert(corners.size() == sizes.size());
+    for (std::size_t i = 0; i != sizes.size(); ++i)
+      {
+        assert(corners[i].x + sizes[i].x <= width);
+        assert(corners[i].y + sizes[i].y <= height);
+        for (std::size_t j = i + 1; j != sizes.size(); ++j)
+          {
+            const bool is_apart{
+              corners[i].x + sizes[i].x + padding <= corners[j].x
+              || corners[j].x + sizes[j].x + padding <= corners[i].x
+              || corners[i].y + sizes[i].y + padding <= corners[j].y
+              || corners[j].y + sizes[j].y + padding <= corners[i].y
+            };
+            assert(is_apart);
+          }
+      }
+  }
+  // The tallest rectangles are on the first shelf
+  {
+    unsigned height{0};
+    const std::vector<sf::Vector2u> corners{
+      pack_on_shelves({{10, 10}, {10, 30}, {10, 20}}, 25, 0, height)
+    };
+    assert(corners[1] == sf::Vector2u(0, 0));
+    assert(corners[2] == sf::Vector2u(10, 0));
+    assert(corners[0] == sf::Vector2u(0, 30));
+    assert(height == 40);
+  }
+  // A rectangle wider than the shelves cannot be packed
+  {
+    unsigned height{0};
+    bool has_thrown{false};
+    try
+    {
+      pack_on_shelves({{100, 10}}, 64, 0, height);
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+  // The shelf width is a power of two, fits the widest rectangle,
+  // and is about the square root of the area
+  {
+    assert(get_shelf_width({{100, 1}}, 0) == 128);
+    assert(get_shelf_width({{10, 10}, {10, 10}, {10, 10}, {10, 10}}, 0) == 32);
+    assert(get_shelf_width({}, 0) == 1);
+  }
+#ifndef LOGIC_ONLY // building the texture needs a graphics context
+  // An atlas has a part of its texture for each image
+  {
+    std::vector<sf::Image> images(3);
+    images[0].create(30, 20);
+    images[1].create(10, 40);
+    images[2].create(16, 16);
+    texture_atlas a;
+    a.build(images);
+    assert(a.get_n_images() == 3);
+    assert(a.get_rect(0).width == 30.0f);
+    assert(a.get_rect(0).height == 20.0f);
+    assert(a.get_rect(1).left == 0.0f);
+    assert(a.get_rect(1).top == 0.0f);
+    assert(a.get_texture().getSize().x >= 30);
+    assert(a.get_texture().getSize().y >= 40);
+  }
+#endif // LOGIC_ONLY
+#endif // no tests in release
+}
@@ -0,0 +1,59 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/// Pack rectangles on shelves: rows that are filled from left to right,
+/// taking the tallest rectangles first. A rectangle that does not fit
+/// on the current shelf starts a new shelf below it.
+/// @param sizes the widths and heights of the rectangles
+/// @param width the width to pack the rectangles in, must be at least
+///   the width of the widest rectangle
+/// @param padding the space between the rectangles
+/// @param height the height needed to pack the rectangles
+/// @return the top-left corner of each rectangle, in the same order as 'sizes'
+std::vector<sf::Vector2u> pack_on_shelves(const std::vector<sf::Vector2u>& sizes,
+                                          const unsigned width,
+                                          const unsigned padding,
+                                          unsigned& height);
+
+/// Get a width to pack rectangles on shelves in, that makes
+/// the packed rectangles about as high as wide. It is a power of two
+unsigned get_shelf_width(const std::vector<sf::Vector2u>& sizes,
+                         const unsigned padding);
+
+/// One texture with many images, so that sprites with different images
+/// can be drawn with one draw call. Each image is found by its index
+class texture_atlas
+{
+public:
+  texture_atlas();
+
+  /// Pack the images in one texture, replacing the earlier ones.
+  /// Throws a std::runtime_error if the images do not fit in a texture
+  /// @param padding the number of transparent pixels between the images,
+  ///   so that a smoothed image does not show a part of its neighbour
+  void build(const std::vector<sf::Image>& images, const unsigned padding = 2);
+
+  /// The texture with all images
+  const sf::Texture& get_texture() const noexcept { return m_texture; }
+
+  /// The number of images in the atlas
+  int get_n_images() const noexcept { return static_cast<int>(m_rects.size()); }
+
+  /// The part of the texture with image i, in pixels,
+  /// as used for the texture coordinates of vertices
+  const sf::FloatRect& get_rect(const int i) const;
+
+private:
+  sf::Texture m_texture;
+
+  /// The part of the texture of each image
+  std::vector<sf::FloatRect> m_rects;
+};
+
+/// Test the texture atlas
+void test_texture_atlas();
+
+#endif // TEXTURE_ATLAS_H
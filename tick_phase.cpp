@@ -0,0 +1,91 @@
+#include "tick_phase.h"
+#include <cassert>
+#include <set>
+#include <sstream>
+
+std::vector<tick_phase> get_all_tick_phases()
+{
+  return {
+    tick_phase::player_collisions,
+    tick_phase::move_projectiles,
+    tick_phase::projectile_collision,
+    tick_phase::cull_projectiles,
+    tick_phase::inertia,
+    tick_phase::move_shelter,
+    tick_phase::do_actions,
+    tick_phase::wall_collisions,
+    tick_phase::food_timers,
+    tick_phase::eat_food,
+    tick_phase::regenerate_food,
+    tick_phase::shooting
+  };
+}
+
+std::string to_str(tick_phase p)
+{
+  switch (p)
+  {
+  case tick_phase::player_collisions:
+    return "player_collisions";
+  case tick_phase::move_projectiles:
+    return "move_projectiles";
+  case tick_phase::projectile_collision:
+    return "projectile_collision";
+  case tick_phase::cull_projectiles:
+    return "cull_projectiles";
+  case tick_phase::inertia:
+    return "inertia";
+  case tick_phase::move_shelter:
+    return "move_shelter";
+  case tick_phase::do_actions:
+    return "do_actions";
+  case tick_phase::wall_collisions:
+    return "wall_collisions";
+  case tick_phase::food_timers:
+    return "food_timers";
+  case tick_phase::eat_food:
+    return "eat_food";
+  case tick_phase::regenerate_food:
+    return "regenerate_food";
+  default:
+    assert(p == tick_phase::shooting);
+    return "shooting";
+  }
+}
+
+std::ostream &operator<<(std::ostream &os, const tick_phase p)
+{
+  os << to_str(p);
+  return os;
+}
+
+void test_tick_phase()
+{
+#ifndef NDEBUG // no tests in release
+  // All phases are there, in order
+  {
+    const std::vector<tick_phase> v{get_all_tick_phases()};
+    assert(static_cast<int>(v.size()) == get_n_tick_phases());
+    for (int i = 0; i != get_n_tick_phases(); ++i)
+      {
+        assert(static_cast<int>(v[i]) == i);
+      }
+  }
+  // All phases have a different name
+  {
+    std::set<std::string> names;
+    for (const auto p : get_all_tick_phases())
+      {
+        names.insert(to_str(p));
+      }
+    assert(static_cast<int>(names.size()) == get_n_tick_phases());
+    assert(to_str(tick_phase::eat_food) == "eat_food");
+  }
+  // A phase can be streamed
+  {
+    std::stringstream s;
+    s << tick_phase::shooting;
+    assert(s.str() == "shooting");
+  }
+#endif // no tests in release
+}
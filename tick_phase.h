@@ -0,0 +1,39 @@
+#ifndef TICK_PHASE_H
+#define TICK_PHASE_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// The phases of game::tick(), in the order these are done
+enum class tick_phase
+{
+  player_collisions,
+  move_projectiles,
+  projectile_collision,
+  cull_projectiles,
+  inertia,
+  move_shelter,
+  do_actions,
+  wall_collisions,
+  food_timers,
+  eat_food,
+  regenerate_food,
+  shooting
+};
+
+/// Get all tick phases, in the order these are done
+std::vector<tick_phase> get_all_tick_phases();
+
+/// The number of tick phases
+constexpr int get_n_tick_phases() noexcept
+{
+  return static_cast<int>(tick_phase::shooting) + 1;
+}
+
+std::string to_str(tick_phase p);
+std::ostream &operator<<(std::ostream &os, const tick_phase p);
+
+void test_tick_phase();
+
+#endif // TICK_PHASE_H
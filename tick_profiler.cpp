@@ -0,0 +1,185 @@
+#include "tick_profiler.h"
+#include "game.h"
+
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+tick_profiler::tick_profiler(const int window_size, const int max_n_events):
+  m_creation{std::chrono::steady_clock::now()},
+  m_histograms(static_cast<std::size_t>(get_n_tick_phases()), rolling_histogram(window_size)),
+  m_events(static_cast<std::size_t>(std::max(max_n_events, 0))),
+  m_next_event{0},
+  m_n_events{0}
+{
+  if (max_n_events < 0)
+    {
+      throw std::invalid_argument("A tick profiler cannot keep a negative number of events");
+    }
+}
+
+void tick_profiler::add(const tick_phase phase,
+                        const int tick,
+                        const std::chrono::steady_clock::time_point start,
+                        const std::chrono::steady_clock::time_point end) noexcept
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  const std::int64_t duration_ns{duration_cast<nanoseconds>(end - start).count()};
+  m_histograms[static_cast<std::size_t>(phase)].add(duration_ns);
+  if (m_events.empty()) return;
+  event& e = m_events[m_next_event];
+  e.m_phase = phase;
+  e.m_tick = tick;
+  e.m_start_ns = duration_cast<nanoseconds>(start - m_creation).count();
+  e.m_duration_ns = duration_ns;
+  m_next_event = (m_next_event + 1) % static_cast<int>(m_events.size());
+  m_n_events = std::min(m_n_events + 1, static_cast<int>(m_events.size()));
+}
+
+const rolling_histogram& tick_profiler::get_histogram(const tick_phase phase) const noexcept
+{
+  return m_histograms[static_cast<std::size_t>(phase)];
+}
+
+std::vector<tick_profiler::event> tick_profiler::get_events() const
+{
+  std::vector<event> events;
+  events.reserve(static_cast<std::size_t>(m_n_events));
+  const int n_max{static_cast<int>(m_events.size())};
+  const int oldest{m_n_events == n_max ? m_next_event : 0};
+  for (int i = 0; i != m_n_events; ++i)
+    {
+      events.push_back(m_events[(oldest + i) % n_max]);
+    }
+  return events;
+}
+
+void write_chrome_trace(std::ostream& os, const tick_profiler& p)
+{
+  // Chrome wants microseconds, keep the nanoseconds as decimals
+  const auto write_us = [&os](const std::int64_t ns)
+  {
+    os << ns / 1000 << '.';
+    const std::string decimals{std::to_string(1000 + (ns % 1000))};
+    os << decimals.substr(1);
+  };
+  os << "{\"traceEvents\":[";
+  bool is_first{true};
+  for (const auto& e : p.get_events())
+    {
+      if (!is_first) os << ',';
+      is_first = false;
+      os << "\n{\"name\":\"" << e.m_phase << "\",\"cat\":\"tick\",\"ph\":\"X\",\"ts\":";
+      write_us(e.m_start_ns);
+      os << ",\"dur\":";
+      write_us(e.m_duration_ns);
+      os << ",\"pid\":0,\"tid\":0,\"args\":{\"tick\":" << e.m_tick << "}}";
+    }
+  os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void write_csv(std::ostream& os, const tick_profiler& p)
+{
+  os << "phase,n,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n";
+  for (const auto phase : get_all_tick_phases())
+    {
+      const rolling_histogram& h = p.get_histogram(phase);
+      os << phase << ','
+         << h.get_n() << ','
+         << h.get_mean() << ','
+         << h.get_percentile(50.0) << ','
+         << h.get_percentile(90.0) << ','
+         << h.get_percentile(99.0) << ','
+         << h.get_max() << '\n';
+    }
+}
+
+void test_tick_profiler() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  using std::chrono::nanoseconds;
+  const auto t0 = std::chrono::steady_clock::now();
+  // A measurement goes to the histogram of its phase
+  {
+    tick_profiler p;
+    p.add(tick_phase::eat_food, 0, t0, t0 + nanoseconds(1500));
+    assert(p.get_histogram(tick_phase::eat_food).get_n() == 1);
+    assert(p.get_histogram(tick_phase::eat_food).get_max() == 1500);
+    assert(p.get_histogram(tick_phase::shooting).get_n() == 0);
+    assert(p.get_events().size() == 1);
+    assert(p.get_events()[0].m_duration_ns == 1500);
+  }
+  // Only the latest events are kept, the oldest first
+  {
+    tick_profiler p(16, 2);
+    p.add(tick_phase::inertia, 0, t0, t0);
+    p.add(tick_phase::inertia, 1, t0, t0);
+    p.add(tick_phase::inertia, 2, t0, t0);
+    const std::vector<tick_profiler::event> events{p.get_events()};
+    assert(events.size() == 2);
+    assert(events[0].m_tick == 1);
+    assert(events[1].m_tick == 2);
+  }
+  // Events can be turned off
+  {
+    tick_profiler p(16, 0);
+    p.add(tick_phase::inertia, 0, t0, t0);
+    assert(p.get_events().empty());
+    assert(p.get_histogram(tick_phase::inertia).get_n() == 1);
+  }
+  // A scoped timer measures its scope, and only with a profiler
+  {
+    tick_profiler p;
+    {
+      const scoped_phase_timer t(&p, tick_phase::move_shelter, 3);
+    }
+    {
+      const scoped_phase_timer t(nullptr, tick_phase::move_shelter, 4);
+    }
+    assert(p.get_histogram(tick_phase::move_shelter).get_n() == 1);
+    assert(p.get_events()[0].m_tick == 3);
+  }
+#ifndef NO_TICK_PROFILER
+  // A game measures all phases of each tick
+  {
+    tick_profiler p;
+    game g;
+    g.set_profiler(&p);
+    g.tick();
+    g.tick();
+    for (const auto phase : get_all_tick_phases())
+      {
+        assert(p.get_histogram(phase).get_n() == 2);
+      }
+    g.set_profiler(nullptr);
+    g.tick();
+    assert(p.get_histogram(tick_phase::shooting).get_n() == 2);
+  }
+#endif // NO_TICK_PROFILER
+  // A Chrome trace has an event per measurement, in microseconds
+  {
+    tick_profiler p;
+    p.add(tick_phase::do_actions, 7, t0, t0 + nanoseconds(2005));
+    std::stringstream s;
+    write_chrome_trace(s, p);
+    const std::string trace{s.str()};
+    assert(trace.find("\"traceEvents\"") != std::string::npos);
+    assert(trace.find("\"name\":\"do_actions\"") != std::string::npos);
+    assert(trace.find("\"dur\":2.005") != std::string::npos);
+    assert(trace.find("\"tick\":7") != std::string::npos);
+  }
+  // The CSV has a header and a line per phase
+  {
+    tick_profiler p;
+    std::stringstream s;
+    write_csv(s, p);
+    int n_lines{0};
+    std::string line;
+    while (std::getline(s, line)) ++n_lines;
+    assert(n_lines == 1 + get_n_tick_phases());
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,108 @@
+#ifndef TICK_PROFILER_H
+#define TICK_PROFILER_H
+
+#include "rolling_histogram.h"
+#include "tick_phase.h"
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+/// Measures how long each phase of game::tick() takes.
+/// Per phase, it keeps a histogram of the latest durations.
+/// It also keeps the latest phases as events, to see them on a timeline.
+/// All memory is allocated up front, so measuring never allocates
+class tick_profiler
+{
+public:
+  /// One phase of one tick
+  struct event
+  {
+    tick_phase m_phase;
+    int m_tick;
+
+    /// The start, in nanoseconds since the profiler was created
+    std::int64_t m_start_ns;
+    std::int64_t m_duration_ns;
+  };
+
+  /// @param window_size the number of latest durations per phase
+  ///   in the histograms
+  /// @param max_n_events the number of latest events kept
+  explicit tick_profiler(const int window_size = 1024,
+                         const int max_n_events = 100000);
+
+  /// Add the measurement of a phase
+  void add(const tick_phase phase,
+           const int tick,
+           const std::chrono::steady_clock::time_point start,
+           const std::chrono::steady_clock::time_point end) noexcept;
+
+  /// Get the histogram of the latest durations of a phase
+  const rolling_histogram& get_histogram(const tick_phase phase) const noexcept;
+
+  /// Get the latest events, the oldest first
+  std::vector<event> get_events() const;
+
+private:
+  std::chrono::steady_clock::time_point m_creation;
+  std::vector<rolling_histogram> m_histograms;
+
+  /// The latest events, m_next_event is the oldest when it is full
+  std::vector<event> m_events;
+  int m_next_event;
+  int m_n_events;
+};
+
+/// Measures a tick phase from its creation to its destruction,
+/// does nothing if there is no profiler
+class scoped_phase_timer
+{
+public:
+  scoped_phase_timer(tick_profiler* const profiler,
+                     const tick_phase phase,
+                     const int tick) noexcept:
+    m_profiler{profiler},
+    m_phase{phase},
+    m_tick{tick},
+    m_start{profiler ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()}
+  {
+  }
+  scoped_phase_timer(const scoped_phase_timer&) = delete;
+  scoped_phase_timer& operator=(const scoped_phase_timer&) = delete;
+  ~scoped_phase_timer()
+  {
+    if (m_profiler)
+      {
+        m_profiler->add(m_phase, m_tick, m_start, std::chrono::steady_clock::now());
+      }
+  }
+
+private:
+  tick_profiler* const m_profiler;
+  const tick_phase m_phase;
+  const int m_tick;
+  const std::chrono::steady_clock::time_point m_start;
+};
+
+/// Measure the rest of the scope as a tick phase.
+/// Define NO_TICK_PROFILER to compile all measurements out
+#ifdef NO_TICK_PROFILER
+#define PROFILE_TICK_PHASE(profiler, phase, tick)
+#else
+#define PROFILE_TICK_PHASE(profiler, phase, tick) \
+  const scoped_phase_timer tick_phase_timer(profiler, phase, tick)
+#endif
+
+/// Write the latest events in the Chrome trace event format,
+/// to view these in chrome://tracing or Perfetto
+void write_chrome_trace(std::ostream& os, const tick_profiler& p);
+
+/// Write the histogram summary of each phase as CSV,
+/// with the header 'phase,n,mean_ns,p50_ns,p90_ns,p99_ns,max_ns'
+void write_csv(std::ostream& os, const tick_profiler& p);
+
+/// Test the tick profiler
+void test_tick_profiler();
+
+#endif // TICK_PROFILER_H
@@ -0,0 +1,139 @@
+#include "timing_wheel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+timing_wheel::timing_wheel(const int n_slots):
+  m_slots(static_cast<std::size_t>(std::max(n_slots, 0))),
+  m_time{0},
+  m_n_scheduled{0}
+{
+  if (n_slots < 1)
+    {
+      throw std::invalid_argument("A timing wheel needs at least one slot");
+    }
+}
+
+void timing_wheel::schedule(const int item, const int time)
+{
+  const int wake_up_time{std::max(time, m_time + 1)};
+  m_slots[wake_up_time % get_n_slots()].push_back({item, wake_up_time});
+  ++m_n_scheduled;
+}
+
+void timing_wheel::advance(std::vector<int>& items)
+{
+  ++m_time;
+  std::vector<wake_up>& slot = m_slots[m_time % get_n_slots()];
+  // Keep the wake-ups of later revolutions, in order
+  auto kept = std::begin(slot);
+  for (const auto& w : slot)
+    {
+      if (w.m_time <= m_time)
+        {
+          items.push_back(w.m_item);
+          --m_n_scheduled;
+        }
+      else
+        {
+          *kept++ = w;
+        }
+    }
+  slot.erase(kept, std::end(slot));
+}
+
+void timing_wheel::reset(const int time)
+{
+  for (auto& slot : m_slots)
+    {
+      slot.clear();
+    }
+  m_time = time;
+  m_n_scheduled = 0;
+}
+
+void test_timing_wheel() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // A new wheel has nothing scheduled
+  {
+    const timing_wheel w;
+    assert(w.get_time() == 0);
+    assert(w.get_n_scheduled() == 0);
+  }
+  // An item wakes up at its time, not before
+  {
+    timing_wheel w(8);
+    w.schedule(42, 3);
+    std::vector<int> items;
+    w.advance(items);
+    w.advance(items);
+    assert(items.empty());
+    w.advance(items);
+    assert(items == std::vector<int>({42}));
+    assert(w.get_n_scheduled() == 0);
+  }
+  // Items that wake up at the same time come in the order these were scheduled
+  {
+    timing_wheel w(8);
+    w.schedule(3, 1);
+    w.schedule(1, 1);
+    w.schedule(2, 1);
+    std::vector<int> items;
+    w.advance(items);
+    assert(items == std::vector<int>({3, 1, 2}));
+  }
+  // Wake-ups more than a revolution away wait for their time
+  {
+    timing_wheel w(4);
+    w.schedule(1, 2);
+    w.schedule(2, 6);
+    w.schedule(3, 10);
+    std::vector<int> items;
+    for (int t = 1; t != 11; ++t)
+      {
+        w.advance(items);
+        if (t < 2) assert(items.empty());
+        if (t == 2) assert(items == std::vector<int>({1}));
+        if (t == 6) assert(items == std::vector<int>({1, 2}));
+      }
+    assert(items == std::vector<int>({1, 2, 3}));
+  }
+  // A time that is not in the future wakes up upon the next advance
+  {
+    timing_wheel w(4);
+    w.reset(100);
+    w.schedule(7, 50);
+    w.schedule(8, 100);
+    std::vector<int> items;
+    w.advance(items);
+    assert(items == std::vector<int>({7, 8}));
+    assert(w.get_time() == 101);
+  }
+  // A reset removes all wake-ups
+  {
+    timing_wheel w(4);
+    w.schedule(1, 2);
+    w.reset(0);
+    assert(w.get_n_scheduled() == 0);
+    std::vector<int> items;
+    w.advance(items);
+    w.advance(items);
+    assert(items.empty());
+  }
+  // A wheel needs a slot
+  {
+    bool has_thrown{false};
+    try
+    {
+      timing_wheel w(0);
+    }
+    catch (const std::invalid_argument&)
+    {
+      has_thrown = true;
+    }
+    assert(has_thrown);
+  }
+#endif // no tests in release
+}
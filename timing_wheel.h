@@ -0,0 +1,54 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+
+/// Schedules items, identified by an index, to wake up at a given time.
+/// The wheel has a number of slots, a wake-up at time t is kept in
+/// slot t modulo the number of slots. Advancing the time by one only
+/// looks at one slot, so its cost depends on the number of items in that
+/// slot, not on the number of items in the wheel. Wake-ups that are more
+/// than a revolution away stay in their slot until their time has come
+class timing_wheel
+{
+public:
+  /// @param n_slots the number of slots, best at least the usual
+  ///   distance between now and a wake-up
+  explicit timing_wheel(const int n_slots = 256);
+
+  /// Schedule an item to wake up at a time. A time that is not in the
+  /// future wakes the item up upon the next advance
+  void schedule(const int item, const int time);
+
+  /// Advance the time by one and append the items that
+  /// wake up to 'items', in the order these were scheduled
+  void advance(std::vector<int>& items);
+
+  /// Remove all wake-ups and set the time
+  void reset(const int time);
+
+  /// The current time
+  int get_time() const noexcept { return m_time; }
+
+  /// The number of wake-ups that are scheduled
+  int get_n_scheduled() const noexcept { return m_n_scheduled; }
+
+  int get_n_slots() const noexcept { return static_cast<int>(m_slots.size()); }
+
+private:
+  /// A scheduled wake-up
+  struct wake_up
+  {
+    int m_item;
+    int m_time;
+  };
+
+  std::vector<std::vector<wake_up>> m_slots;
+  int m_time;
+  int m_n_scheduled;
+};
+
+/// Test the timing_wheel class
+void test_timing_wheel();
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,92 @@
+#include "triple_buffer.h"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+void test_triple_buffer() //!OCLINT tests may be many
+{
+#ifndef NDEBUG // no tests in release
+  // Nothing is new before the first value is published
+  {
+    triple_buffer<int> b;
+    assert(!b.update());
+  }
+  // The reader gets the published value, once
+  {
+    triple_buffer<int> b;
+    b.get_back() = 42;
+    b.publish();
+    assert(b.update());
+    assert(b.get_front() == 42);
+    assert(!b.update());
+    assert(b.get_front() == 42);
+  }
+  // The reader gets the newest value only
+  {
+    triple_buffer<int> b;
+    for (int i = 1; i != 10; ++i)
+      {
+        b.get_back() = i;
+        b.publish();
+      }
+    assert(b.update());
+    assert(b.get_front() == 9);
+  }
+  // The writer never writes to the buffer the reader has
+  {
+    triple_buffer<int> b;
+    b.get_back() = 1;
+    b.publish();
+    assert(b.update());
+    for (int i = 2; i != 10; ++i)
+      {
+        assert(&b.get_back() != &b.get_front());
+        b.get_back() = i;
+        b.publish();
+      }
+    assert(b.get_front() == 1);
+  }
+  // Buffers are reused, so these keep their memory
+  {
+    triple_buffer<std::vector<int>> b;
+    for (int i = 0; i != 3; ++i)
+      {
+        b.get_back().assign(100, i);
+        b.publish();
+        b.update();
+      }
+    b.get_back().clear();
+    assert(b.get_back().capacity() >= 100);
+  }
+  // Across threads, the reader sees whole values, newer ones only,
+  // and ends with the last one
+  {
+    const int n_values{10000};
+    triple_buffer<std::vector<int>> b;
+    std::thread writer([&b, n_values]()
+    {
+      for (int i = 1; i <= n_values; ++i)
+        {
+          b.get_back().assign(16, i);
+          b.publish();
+        }
+    });
+    int latest{0};
+    while (latest != n_values)
+      {
+        if (!b.update())
+          {
+            std::this_thread::yield();
+            continue;
+          }
+        const std::vector<int>& v = b.get_front();
+        assert(v.size() == 16);
+        assert(v.front() == v.back());
+        assert(v.front() > latest);
+        latest = v.front();
+      }
+    writer.join();
+  }
+#endif // no tests in release
+}
@@ -0,0 +1,71 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+
+/// Passes the newest value from one writer thread to one reader thread,
+/// without locks and without either thread ever waiting for the other.
+/// Of the three buffers, the writer owns one, the reader owns one,
+/// and the third is the newest value published, which the threads swap
+/// with their own buffer. The reader may skip values, it always gets
+/// the newest one. As the buffers are reused, a value that keeps
+/// its memory, such as a std::vector, stops allocating once filled
+template <class T>
+class triple_buffer
+{
+public:
+  triple_buffer() : m_back{0}, m_shared{1}, m_front{2} {}
+
+  triple_buffer(const triple_buffer&) = delete;
+  triple_buffer& operator=(const triple_buffer&) = delete;
+
+  /// Writer: get the buffer to write the next value to,
+  /// which holds an older value
+  T& get_back() noexcept { return m_buffers[m_back]; }
+
+  /// Writer: publish the value written to the back buffer,
+  /// and get another buffer to write to
+  void publish() noexcept
+  {
+    const int old_shared{m_shared.exchange(m_back | m_new_bit, std::memory_order_acq_rel)};
+    m_back = old_shared & m_index_mask;
+  }
+
+  /// Reader: take the newest value published, if there is one.
+  /// Returns true if the front buffer changed
+  bool update() noexcept
+  {
+    if (!(m_shared.load(std::memory_order_relaxed) & m_new_bit)) return false;
+    const int old_shared{m_shared.exchange(m_front, std::memory_order_acq_rel)};
+    m_front = old_shared & m_index_mask;
+    return true;
+  }
+
+  /// Reader: get the newest value taken by 'update'
+  const T& get_front() const noexcept { return m_buffers[m_front]; }
+
+private:
+  /// The bit in m_shared that is set if the writer published
+  /// a value the reader did not take yet
+  static constexpr int m_new_bit = 4;
+
+  /// The bits in m_shared with the index of the shared buffer
+  static constexpr int m_index_mask = 3;
+
+  std::array<T, 3> m_buffers;
+
+  /// The index of the buffer of the writer
+  int m_back;
+
+  /// The index of the shared buffer, with the new bit
+  std::atomic<int> m_shared;
+
+  /// The index of the buffer of the reader
+  int m_front;
+};
+
+/// Test the triple_buffer class
+void test_triple_buffer();
+
+#endif // TRIPLE_BUFFER_H